@@ -0,0 +1,68 @@
+# Loopback throughput benchmark for the playerbots command server (AiPlayerbot.CommandServerPort).
+#
+# Opens a number of connections, pipelines requests on each of them and reports requests per second.
+# Requests are "<command>,<bot guid>" lines as handled by RandomPlayerbotMgr::HandleRemoteCommand.
+#
+# usage: python3 commandserver-bench.py [--host 127.0.0.1] [--port 8888] [--connections 8]
+#                                       [--requests 10000] [--pipeline 64] [--request state,1]
+
+import argparse
+import socket
+import threading
+import time
+
+
+def run_connection(args, results, index):
+    sock = socket.create_connection((args.host, args.port))
+    request = (args.request + "\n").encode()
+    received = 0
+    sent = 0
+    buffer = b""
+
+    while received < args.requests:
+        # keep up to --pipeline requests in flight
+        burst = min(args.pipeline - (sent - received), args.requests - sent)
+        if burst > 0:
+            sock.sendall(request * burst)
+            sent += burst
+
+        data = sock.recv(65536)
+        if not data:
+            break
+
+        buffer += data
+        lines = buffer.count(b"\n")
+        received += lines
+        buffer = buffer[buffer.rfind(b"\n") + 1:]
+
+    sock.close()
+    results[index] = received
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8888)
+    parser.add_argument("--connections", type=int, default=8)
+    parser.add_argument("--requests", type=int, default=10000, help="requests per connection")
+    parser.add_argument("--pipeline", type=int, default=64, help="requests in flight per connection")
+    parser.add_argument("--request", default="state,1")
+    args = parser.parse_args()
+
+    results = [0] * args.connections
+    threads = [threading.Thread(target=run_connection, args=(args, results, i)) for i in range(args.connections)]
+
+    start = time.perf_counter()
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    elapsed = time.perf_counter() - start
+
+    total = sum(results)
+    print("{} responses over {} connections in {:.2f} s: {:.0f} requests/s".format(
+        total, args.connections, elapsed, total / elapsed if elapsed else 0))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+// Multithreaded lookup benchmark for PlayerbotRegistry against the unordered_map it replaced.
+//
+// Registers a number of bots, then reader threads resolve random bot guids through both containers and the lookups
+// per second are reported. A second phase churns logins and logouts on other guids while readers keep resolving the
+// registered bots, any lookup that comes back empty aborts.
+//
+// Built against the core headers the module is compiled with, e.g. from the core build tree:
+//   g++ -O2 -std=c++20 -pthread <core include flags> -I modules/mod-playerbots/src \
+//       modules/mod-playerbots/apps/registry/registry-bench.cpp modules/mod-playerbots/src/PlayerbotRegistry.cpp
+//
+// usage: registry-bench [bots=5000] [threads=8] [lookups=20000000]
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "PlayerbotRegistry.h"
+
+class PlayerbotAIBase
+{
+};
+
+template <class Lookup>
+static double MeasureLookups(std::vector<ObjectGuid> const& guids, uint32 threads, uint32 lookups, Lookup lookup)
+{
+    std::atomic<uint64> sink(0);
+    std::vector<std::thread> readers;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 t = 0; t < threads; ++t)
+    {
+        readers.emplace_back(
+            [&, t]()
+            {
+                uint64 found = 0;
+                uint32 index = t * 7919;
+                for (uint32 i = 0; i < lookups / threads; ++i)
+                {
+                    index = (index + 2654435761u) % guids.size();
+                    found += lookup(guids[index]) != nullptr;
+                }
+
+                sink += found;
+            });
+    }
+
+    for (std::thread& reader : readers)
+        reader.join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return lookups / seconds / 1000000.0;
+}
+
+int main(int argc, char** argv)
+{
+    uint32 bots = argc > 1 ? std::atoi(argv[1]) : 5000;
+    uint32 threads = argc > 2 ? std::atoi(argv[2]) : 8;
+    uint32 lookups = argc > 3 ? std::atoi(argv[3]) : 20000000;
+
+    PlayerbotRegistry registry;
+    std::unordered_map<ObjectGuid, PlayerbotAIBase*> map;
+    std::vector<PlayerbotAIBase> ais(bots);
+    std::vector<ObjectGuid> guids;
+
+    // spread like character guids, not packed from zero
+    for (uint32 i = 0; i < bots; ++i)
+    {
+        ObjectGuid guid = ObjectGuid::Create<HighGuid::Player>(100000 + i * 3);
+        guids.push_back(guid);
+        registry.Set(guid, &ais[i]);
+        map[guid] = &ais[i];
+    }
+
+    double registryRate =
+        MeasureLookups(guids, threads, lookups, [&](ObjectGuid const& guid) { return registry.Get(guid); });
+    double mapRate = MeasureLookups(guids, threads, lookups,
+                                    [&](ObjectGuid const& guid)
+                                    {
+                                        auto it = map.find(guid);
+                                        return it == map.end() ? nullptr : it->second;
+                                    });
+
+    printf("registry %.1f M lookups/s, unordered_map %.1f M lookups/s (%u threads, %u bots)\n", registryRate, mapRate,
+           threads, bots);
+
+    // logins and logouts of other bots while the registered ones are resolved
+    std::atomic<bool> stop(false);
+    std::thread writer(
+        [&]()
+        {
+            for (uint32 i = 0; i < 200000; ++i)
+            {
+                ObjectGuid guid = ObjectGuid::Create<HighGuid::Player>((1 << 20) + i * 97 % (1 << 22));
+                registry.Set(guid, &ais[i % bots]);
+                registry.Remove(guid, &ais[i % bots]);
+            }
+
+            stop = true;
+        });
+
+    std::vector<std::thread> readers;
+    for (uint32 t = 0; t < threads; ++t)
+    {
+        readers.emplace_back(
+            [&]()
+            {
+                while (!stop)
+                {
+                    for (ObjectGuid const& guid : guids)
+                    {
+                        if (!registry.Get(guid))
+                        {
+                            printf("lookup lost a registered bot\n");
+                            std::abort();
+                        }
+                    }
+                }
+            });
+    }
+
+    writer.join();
+    for (std::thread& reader : readers)
+        reader.join();
+
+    printf("churn ok, %u bots registered in %u segments\n", registry.GetCount(), registry.GetSegmentCount());
+    return 0;
+}
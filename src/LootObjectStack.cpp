@@ -5,6 +5,8 @@
 
 #include "LootObjectStack.h"
 
+#include <algorithm>
+
 #include "LootMgr.h"
 #include "Object.h"
 #include "ObjectAccessor.h"
@@ -12,37 +14,27 @@
 #include "Unit.h"
 
 #define MAX_LOOT_OBJECT_COUNT 200
-
-LootTarget::LootTarget(ObjectGuid guid) : guid(guid), asOfTime(time(nullptr)) {}
-
-LootTarget::LootTarget(LootTarget const& other)
+#define LOOT_EVALUATION_TTL 3
+
+LootTarget::LootTarget(ObjectGuid guid)
+    : guid(guid),
+      asOfTime(time(nullptr)),
+      stateSignature(0),
+      evaluatedAt(0),
+      distance(std::numeric_limits<float>::max()),
+      lootPossible(false)
 {
-    guid = other.guid;
-    asOfTime = other.asOfTime;
 }
 
-LootTarget& LootTarget::operator=(LootTarget const& other)
+void LootTargetList::shrink(time_t fromTime)
 {
-    if ((void*)this == (void*)&other)
-        return *this;
-
-    guid = other.guid;
-    asOfTime = other.asOfTime;
-
-    return *this;
+    erase(std::remove_if(begin(), end(), [fromTime](LootTarget const& target) { return target.asOfTime <= fromTime; }),
+          end());
 }
 
-bool LootTarget::operator<(LootTarget const& other) const { return guid < other.guid; }
-
-void LootTargetList::shrink(time_t fromTime)
+LootTargetList::iterator LootTargetList::find(ObjectGuid guid)
 {
-    for (std::set<LootTarget>::iterator i = begin(); i != end();)
-    {
-        if (i->asOfTime <= fromTime)
-            erase(i++);
-        else
-            ++i;
-    }
+    return std::find_if(begin(), end(), [guid](LootTarget const& target) { return target.guid == guid; });
 }
 
 LootObject::LootObject(Player* bot, ObjectGuid guid) : guid(), skillId(SKILL_NONE), reqSkillValue(0), reqItem(0)
@@ -277,8 +269,12 @@ bool LootObject::IsLootPossible(Player* bot)
     if (IsEmpty() || !bot)
         return false;
 
-    WorldObject* worldObj = GetWorldObject(bot);  // Store result to avoid multiple calls
-    if (!worldObj)
+    return IsLootPossible(bot, GetWorldObject(bot));
+}
+
+bool LootObject::IsLootPossible(Player* bot, WorldObject* worldObj)
+{
+    if (IsEmpty() || !bot || !worldObj || !worldObj->IsInWorld())
         return false;
 
     PlayerbotAI* botAI = GET_PLAYERBOT_AI(bot);
@@ -292,16 +288,19 @@ bool LootObject::IsLootPossible(Player* bot)
     if (abs(worldObj->GetPositionZ() - bot->GetPositionZ()) > INTERACTION_DISTANCE - 2.0f)
         return false;
 
-    Creature* creature = botAI->GetCreature(guid);
-    if (creature && creature->getDeathState() == DeathState::Corpse)
+    Creature* creature = worldObj->ToCreature();
+    if (creature)
     {
+        if (creature->getDeathState() != DeathState::Corpse)
+            return false;
+
         if (!bot->isAllowedToLoot(creature) && skillId != SKILL_SKINNING)
             return false;
     }
 
     // Prevent bot from running to chests that are unlootable (e.g. Gunship Armory before completing the event) or on
     // respawn time
-    GameObject* go = botAI->GetGameObject(guid);
+    GameObject* go = worldObj->ToGameObject();
     if (go && (go->HasFlag(GAMEOBJECT_FLAGS, GO_FLAG_INTERACT_COND | GO_FLAG_NOT_SELECTABLE) || !go->isSpawned()))
         return false;
 
@@ -340,19 +339,32 @@ bool LootObject::IsLootPossible(Player* bot)
 
 bool LootObjectStack::Add(ObjectGuid guid)
 {
+    if (availableLoot.find(guid) != availableLoot.end())
+        return false;
+
     if (availableLoot.size() >= MAX_LOOT_OBJECT_COUNT)
     {
         availableLoot.shrink(time(nullptr) - 30);
     }
 
+    // drop the candidate farthest away now, gone objects count as farthest
     if (availableLoot.size() >= MAX_LOOT_OBJECT_COUNT)
     {
-        availableLoot.clear();
+        for (LootTarget& target : availableLoot)
+        {
+            WorldObject* worldObj = ObjectAccessor::GetWorldObject(*bot, target.guid);
+            target.distance = worldObj ? bot->GetDistance(worldObj) : std::numeric_limits<float>::max();
+        }
+
+        availableLoot.erase(std::max_element(availableLoot.begin(), availableLoot.end()));
+        std::stable_sort(availableLoot.begin(), availableLoot.end());
     }
 
-    if (!availableLoot.insert(guid).second)
-        return false;
+    LootTarget target(guid);
+    if (WorldObject* worldObj = ObjectAccessor::GetWorldObject(*bot, guid))
+        target.distance = bot->GetDistance(worldObj);
 
+    availableLoot.insert(std::upper_bound(availableLoot.begin(), availableLoot.end(), target), target);
     return true;
 }
 
@@ -377,35 +389,73 @@ LootObject LootObjectStack::GetLoot(float maxDistance)
     return nearest.IsEmpty() ? LootObject() : nearest;
 }
 
-LootObject LootObjectStack::GetNearest(float maxDistance)
+uint32 LootObjectStack::GetStateSignature(WorldObject* worldObj)
 {
-    availableLoot.shrink(time(nullptr) - 30);
-
-    LootObject nearest;
-    float nearestDistance = std::numeric_limits<float>::max();
+    if (Creature* creature = worldObj->ToCreature())
+    {
+        return 0x80000000 | (uint32(creature->getDeathState()) << 16) |
+               (creature->HasFlag(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_LOOTABLE) ? 0x2 : 0) |
+               (creature->HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_SKINNABLE) ? 0x1 : 0);
+    }
 
-    LootTargetList safeCopy(availableLoot);
-    for (LootTargetList::iterator i = safeCopy.begin(); i != safeCopy.end(); i++)
+    if (GameObject* go = worldObj->ToGameObject())
     {
-        ObjectGuid guid = i->guid;
+        return (uint32(go->GetGoState()) << 16) | (uint32(go->getLootState()) << 8) | (go->isSpawned() ? 0x4 : 0) |
+               (go->HasFlag(GAMEOBJECT_FLAGS, GO_FLAG_INTERACT_COND | GO_FLAG_NOT_SELECTABLE) ? 0x2 : 0);
+    }
+
+    return 0;
+}
+
+bool LootObjectStack::Evaluate(LootTarget& target, WorldObject* worldObj, time_t now)
+{
+    // bot side requirements (skills, tools, quest items) are not tracked, so cached results also age out
+    uint32 signature = GetStateSignature(worldObj);
+    if (target.evaluatedAt && target.stateSignature == signature && now - target.evaluatedAt < LOOT_EVALUATION_TTL)
+        return target.lootPossible;
+
+    target.lootObject.Refresh(bot, target.guid);
+    target.lootPossible = target.lootObject.IsLootPossible(bot, worldObj);
+    target.stateSignature = signature;
+    target.evaluatedAt = now;
 
-        WorldObject* worldObj = ObjectAccessor::GetWorldObject(*bot, guid);
+    return target.lootPossible;
+}
+
+LootObject LootObjectStack::GetNearest(float maxDistance)
+{
+    time_t now = time(nullptr);
+    availableLoot.shrink(now - 30);
+
+    LootTarget* nearest = nullptr;
+    for (LootTarget& target : availableLoot)
+    {
+        WorldObject* worldObj = ObjectAccessor::GetWorldObject(*bot, target.guid);
         if (!worldObj)
+        {
+            target.distance = std::numeric_limits<float>::max();
             continue;
+        }
 
-        float distance = bot->GetDistance(worldObj);
+        target.distance = bot->GetDistance(worldObj);
 
-        if (distance >= nearestDistance || (maxDistance && distance > maxDistance))
+        // no early exit: the order is from the last poll and the bot moved since, an entry now out of range can sit
+        // before one that came into range, and the sort below needs every distance refreshed
+        if (maxDistance && target.distance > maxDistance)
             continue;
 
-        LootObject lootObject(bot, guid);
-
-        if (!lootObject.IsLootPossible(bot))
+        if (nearest && target.distance >= nearest->distance)
             continue;
 
-        nearestDistance = distance;
-        nearest = lootObject;
+        if (Evaluate(target, worldObj, now))
+            nearest = &target;
     }
 
-    return nearest;
+    LootObject result = nearest ? nearest->lootObject : LootObject();
+
+    // the bot moves a little between polls, so the list is usually still sorted
+    if (!std::is_sorted(availableLoot.begin(), availableLoot.end()))
+        std::stable_sort(availableLoot.begin(), availableLoot.end());
+
+    return result;
 }
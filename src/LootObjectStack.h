@@ -6,6 +6,8 @@
 #ifndef _PLAYERBOT_LOOTOBJECTSTACK_H
 #define _PLAYERBOT_LOOTOBJECTSTACK_H
 
+#include <vector>
+
 #include "ObjectGuid.h"
 
 class AiObjectContext;
@@ -33,6 +35,7 @@ public:
 
     bool IsEmpty() { return !guid; }
     bool IsLootPossible(Player* bot);
+    bool IsLootPossible(Player* bot, WorldObject* worldObj);
     void Refresh(Player* bot, ObjectGuid guid);
     WorldObject* GetWorldObject(Player* bot);
     ObjectGuid guid;
@@ -45,25 +48,35 @@ private:
     static bool IsNeededForQuest(Player* bot, uint32 itemId);
 };
 
+// Loot candidate with its cached LootObject evaluation. The evaluation is kept until the
+// object's loot state changes or it ages out, so polling the stack does not re-run Refresh.
 class LootTarget
 {
 public:
     LootTarget(ObjectGuid guid);
-    LootTarget(LootTarget const& other);
+    LootTarget(LootTarget const& other) = default;
 
 public:
-    LootTarget& operator=(LootTarget const& other);
-    bool operator<(LootTarget const& other) const;
+    LootTarget& operator=(LootTarget const& other) = default;
+    bool operator<(LootTarget const& other) const { return distance < other.distance; }
 
 public:
     ObjectGuid guid;
     time_t asOfTime;
+
+    LootObject lootObject;
+    uint32 stateSignature;
+    time_t evaluatedAt;
+    float distance;
+    bool lootPossible;
 };
 
-class LootTargetList : public std::set<LootTarget>
+// kept ordered by the bot's distance to each candidate as of the last query
+class LootTargetList : public std::vector<LootTarget>
 {
 public:
     void shrink(time_t fromTime);
+    iterator find(ObjectGuid guid);
 };
 
 class LootObjectStack
@@ -79,6 +92,8 @@ public:
 
 private:
     LootObject GetNearest(float maxDistance = 0);
+    bool Evaluate(LootTarget& target, WorldObject* worldObj, time_t now);
+    static uint32 GetStateSignature(WorldObject* worldObj);
 
     Player* bot;
     LootTargetList availableLoot;
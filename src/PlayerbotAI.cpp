@@ -42,7 +42,9 @@
 #include "Player.h"
 #include "PlayerbotAIConfig.h"
 #include "PlayerbotDbStore.h"
+#include "PlayerbotGearScore.h"
 #include "PlayerbotMgr.h"
+#include "PlayerbotPacketEvents.h"
 #include "Playerbots.h"
 #include "PointMovementGenerator.h"
 #include "PositionValue.h"
@@ -82,26 +84,43 @@ uint32 PlayerbotChatHandler::extractQuestId(std::string const str)
     return cId ? atol(cId) : 0;
 }
 
-void PacketHandlingHelper::AddHandler(uint16 opcode, std::string const handler) { handlers[opcode] = handler; }
+void PacketHandlingHelper::AddHandler(uint16 opcode, std::string const handler)
+{
+    handlers[opcode] = handler;
+    if (opcode < NUM_MSG_TYPES)
+        handledOpcodes.set(opcode);
+}
 
 void PacketHandlingHelper::Handle(ExternalEventHelper& helper)
 {
-    while (!queue.empty())
+    while (queueCount)
     {
-        helper.HandlePacket(handlers, queue.top());
-        queue.pop();
+        helper.HandlePacket(handlers, queue[queueHead]);
+        queueHead = (queueHead + 1) % queue.size();
+        --queueCount;
     }
+
+    queueHead = 0;
 }
 
 void PacketHandlingHelper::AddPacket(WorldPacket const& packet)
 {
-    if (packet.empty())
+    if (packet.empty() || !IsHandled(packet.GetOpcode()))
         return;
-    // assert(handlers);
-    // assert(packet);
-    // assert(packet.GetOpcode());
-    if (handlers.find(packet.GetOpcode()) != handlers.end())
-        queue.push(WorldPacket(packet));
+
+    if (queueCount == queue.size())
+    {
+        // grow and unwrap, slots keep their buffers so steady state copies do not allocate
+        std::vector<WorldPacket> grown(std::max<size_t>(PACKET_QUEUE_INITIAL_SIZE, queue.size() * 2));
+        for (uint32 i = 0; i < queueCount; ++i)
+            std::swap(grown[i], queue[(queueHead + i) % queue.size()]);
+
+        queue.swap(grown);
+        queueHead = 0;
+    }
+
+    queue[(queueHead + queueCount) % queue.size()] = packet;
+    ++queueCount;
 }
 
 PlayerbotAI::PlayerbotAI()
@@ -229,8 +248,10 @@ PlayerbotAI::~PlayerbotAI()
     if (aiObjectContext)
         delete aiObjectContext;
 
+    sPlayerbotStats->Untrack(this);
+
     if (bot)
-        sPlayerbotsMgr->RemovePlayerBotData(bot->GetGUID(), true);
+        sPlayerbotsMgr->RemovePlayerBotData(bot->GetGUID(), true, this);
 }
 
 void PlayerbotAI::UpdateAI(uint32 elapsed, bool minimal)
@@ -262,6 +283,9 @@ void PlayerbotAI::UpdateAI(uint32 elapsed, bool minimal)
 
     AllowActivity();
 
+    activityTier = CalculateActivityTier();
+    sPlayerbotStats->Publish(this);
+
     if (!CanUpdateAI())
         return;
 
@@ -439,6 +463,9 @@ void PlayerbotAI::UpdateAIInternal([[maybe_unused]] uint32 elapsed, bool minimal
     if (bot->IsBeingTeleported() || !bot->IsInWorld())
         return;
 
+    // castability checks are only remembered within one tick
+    castCheckMemo.clear();
+
     std::string const mapString = WorldPosition(bot).isOverworld() ? std::to_string(bot->GetMapId()) : "I";
     PerformanceMonitorOperation* pmo =
         sPerformanceMonitor->start(PERF_MON_TOTAL, "PlayerbotAI::UpdateAIInternal " + mapString);
@@ -984,53 +1011,64 @@ void PlayerbotAI::HandleCommand(uint32 type, std::string const text, Player* fro
     }
 }
 
+bool PlayerbotAI::IsDirectlyHandledOpcode(uint16 opcode)
+{
+    switch (opcode)
+    {
+        case SMSG_SPELL_FAILURE:
+        case SMSG_SPELL_DELAYED:
+        case SMSG_EMOTE:
+        case SMSG_MESSAGECHAT:
+        case SMSG_MOVE_KNOCK_BACK:
+        case SMSG_QUESTUPDATE_ADD_KILL:
+        case SMSG_QUESTUPDATE_COMPLETE:
+        case SMSG_QUESTUPDATE_FAILED:
+        case SMSG_QUESTUPDATE_FAILEDTIMER:
+            return true;
+        default:
+            return false;
+    }
+}
+
 void PlayerbotAI::HandleBotOutgoingPacket(WorldPacket const& packet)
 {
     if (packet.empty())
         return;
+
+    // most packets built for a bot are of no interest, reject them with a single bit test
+    uint16 const opcode = packet.GetOpcode();
+    if (!IsDirectlyHandledOpcode(opcode) && !botOutgoingPacketHandlers.IsHandled(opcode))
+        return;
+
     if (!bot || !bot->IsInWorld() || bot->IsDuringRemoveFromWorld())
     {
         return;
     }
-    switch (packet.GetOpcode())
+    switch (opcode)
     {
         case SMSG_SPELL_FAILURE:
         {
-            WorldPacket p(packet);
-            p.rpos(0);
-            ObjectGuid casterGuid;
-            p >> casterGuid.ReadAsPacked();
-            if (casterGuid != bot->GetGUID())
+            BotSpellFailureEvent spellFailure;
+            if (!spellFailure.Read(packet) || spellFailure.caster != bot->GetGUID())
                 return;
-            uint8 count, result;
-            uint32 spellId;
-            p >> count >> spellId >> result;
-            SpellInterrupted(spellId);
+
+            SpellInterrupted(spellFailure.spellId);
             return;
         }
         case SMSG_SPELL_DELAYED:
         {
-            WorldPacket p(packet);
-            p.rpos(0);
-            ObjectGuid casterGuid;
-            p >> casterGuid.ReadAsPacked();
-            if (casterGuid != bot->GetGUID())
+            BotSpellDelayedEvent spellDelayed;
+            if (!spellDelayed.Read(packet) || spellDelayed.caster != bot->GetGUID())
                 return;
 
-            uint32 delaytime;
-            p >> delaytime;
-            if (delaytime <= 1000)
-                IncreaseNextCheckDelay(delaytime);
+            if (spellDelayed.delayTime <= 1000)
+                IncreaseNextCheckDelay(spellDelayed.delayTime);
             return;
         }
         case SMSG_EMOTE:  // do not react to NPC emotes
         {
-            WorldPacket p(packet);
-            ObjectGuid source;
-            uint32 emoteId;
-            p.rpos(0);
-            p >> emoteId >> source;
-            if (source.IsPlayer())
+            BotEmoteEvent emote;
+            if (emote.Read(packet) && emote.source.IsPlayer())
                 botOutgoingPacketHandlers.AddPacket(packet);
 
             return;
@@ -1043,132 +1081,104 @@ void PlayerbotAI::HandleBotOutgoingPacket(WorldPacket const& packet)
             if (!AllowActivity())
                 return;
 
-            WorldPacket p(packet);
-            if (!p.empty() && (p.GetOpcode() == SMSG_MESSAGECHAT || p.GetOpcode() == SMSG_GM_MESSAGECHAT))
+            BotChatEvent chat;
+            if (!chat.Read(packet))
+                return;
+
+            uint8 const msgtype = chat.msgType;
+            ObjectGuid const guid1 = chat.sender;
+            if (guid1.IsEmpty() || packet.size() > packet.DEFAULT_SIZE)
+                return;
+
+            if (chat.channelName == "World")
+                return;
+
+            // do not reply to self but always try to reply to real player
+            if (guid1 != bot->GetGUID())
             {
-                p.rpos(0);
-                uint8 msgtype, chatTag;
-                uint32 lang, textLen, unused;
-                ObjectGuid guid1, guid2;
-                std::string name = "";
-                std::string chanName = "";
-                std::string message = "";
-
-                p >> msgtype >> lang;
-                p >> guid1 >> unused;
-                if (guid1.IsEmpty() || p.size() > p.DEFAULT_SIZE)
+                std::string const message(chat.message);
+                std::string const chanName(chat.channelName);
+                std::string name(chat.senderName);
+                time_t lastChat = GetAiObjectContext()->GetValue<time_t>("last said", "chat")->Get();
+                bool isPaused = time(0) < lastChat;
+                bool isFromFreeBot = false;
+                sCharacterCache->GetCharacterNameByGuid(guid1, name);
+                uint32 accountId = sCharacterCache->GetCharacterAccountIdByGuid(guid1);
+                isFromFreeBot = sPlayerbotAIConfig->IsInRandomAccountList(accountId);
+                bool isMentioned = message.find(bot->GetName()) != std::string::npos;
+
+                // ChatChannelSource chatChannelSource = GetChatChannelSource(bot, msgtype, chanName);
+
+                // random bot speaks, chat CD
+                if (isFromFreeBot && isPaused)
                     return;
 
-                if (p.GetOpcode() == SMSG_GM_MESSAGECHAT)
-                {
-                    p >> textLen;
-                    p >> name;
-                }
+                // BG: react only if mentioned or if not channel and real player spoke
+                if (bot->InBattleground() && !(isMentioned || (msgtype != CHAT_MSG_CHANNEL && !isFromFreeBot)))
+                    return;
 
-                switch (msgtype)
+                if (HasRealPlayerMaster() && guid1 != GetMaster()->GetGUID())
+                    return;
+                if (chat.lang == LANG_ADDON)
+                    return;
+
+                if (message.starts_with(sPlayerbotAIConfig->toxicLinksPrefix) &&
+                    (GetChatHelper()->ExtractAllItemIds(message).size() > 0 ||
+                     GetChatHelper()->ExtractAllQuestIds(message).size() > 0) &&
+                    sPlayerbotAIConfig->toxicLinksRepliesChance)
                 {
-                    case CHAT_MSG_CHANNEL:
-                        p >> chanName;
-                        [[fallthrough]];
-                    case CHAT_MSG_SAY:
-                    case CHAT_MSG_PARTY:
-                    case CHAT_MSG_YELL:
-                    case CHAT_MSG_WHISPER:
-                    case CHAT_MSG_GUILD:
-                        p >> guid2;
-                        p >> textLen >> message >> chatTag;
-                        break;
-                    default:
+                    if (urand(0, 50) > 0 || urand(1, 100) > sPlayerbotAIConfig->toxicLinksRepliesChance)
+                    {
                         return;
+                    }
                 }
-
-                if (chanName == "World")
-                    return;
-
-                // do not reply to self but always try to reply to real player
-                if (guid1 != bot->GetGUID())
+                else if ((GetChatHelper()->ExtractAllItemIds(message).count(19019) &&
+                          sPlayerbotAIConfig->thunderfuryRepliesChance))
                 {
-                    time_t lastChat = GetAiObjectContext()->GetValue<time_t>("last said", "chat")->Get();
-                    bool isPaused = time(0) < lastChat;
-                    bool isFromFreeBot = false;
-                    sCharacterCache->GetCharacterNameByGuid(guid1, name);
-                    uint32 accountId = sCharacterCache->GetCharacterAccountIdByGuid(guid1);
-                    isFromFreeBot = sPlayerbotAIConfig->IsInRandomAccountList(accountId);
-                    bool isMentioned = message.find(bot->GetName()) != std::string::npos;
-
-                    // ChatChannelSource chatChannelSource = GetChatChannelSource(bot, msgtype, chanName);
-
-                    // random bot speaks, chat CD
-                    if (isFromFreeBot && isPaused)
+                    if (urand(0, 60) > 0 || urand(1, 100) > sPlayerbotAIConfig->thunderfuryRepliesChance)
+                    {
                         return;
-
-                    // BG: react only if mentioned or if not channel and real player spoke
-                    if (bot->InBattleground() && !(isMentioned || (msgtype != CHAT_MSG_CHANNEL && !isFromFreeBot)))
+                    }
+                }
+                else
+                {
+                    if (isFromFreeBot && urand(0, 20))
                         return;
 
-                    if (HasRealPlayerMaster() && guid1 != GetMaster()->GetGUID())
-                        return;
-                    if (lang == LANG_ADDON)
-                        return;
+                    // if (msgtype == CHAT_MSG_GUILD && (!sPlayerbotAIConfig->guildRepliesRate || urand(1, 100) >=
+                    // sPlayerbotAIConfig->guildRepliesRate)) return;
 
-                    if (message.starts_with(sPlayerbotAIConfig->toxicLinksPrefix) &&
-                        (GetChatHelper()->ExtractAllItemIds(message).size() > 0 ||
-                         GetChatHelper()->ExtractAllQuestIds(message).size() > 0) &&
-                        sPlayerbotAIConfig->toxicLinksRepliesChance)
-                    {
-                        if (urand(0, 50) > 0 || urand(1, 100) > sPlayerbotAIConfig->toxicLinksRepliesChance)
-                        {
-                            return;
-                        }
-                    }
-                    else if ((GetChatHelper()->ExtractAllItemIds(message).count(19019) &&
-                              sPlayerbotAIConfig->thunderfuryRepliesChance))
+                    if (!isFromFreeBot)
                     {
-                        if (urand(0, 60) > 0 || urand(1, 100) > sPlayerbotAIConfig->thunderfuryRepliesChance)
-                        {
+                        if (!isMentioned && urand(0, 4))
                             return;
-                        }
                     }
                     else
                     {
-                        if (isFromFreeBot && urand(0, 20))
+                        if (urand(0, 20 + 10 * isMentioned))
                             return;
-
-                        // if (msgtype == CHAT_MSG_GUILD && (!sPlayerbotAIConfig->guildRepliesRate || urand(1, 100) >=
-                        // sPlayerbotAIConfig->guildRepliesRate)) return;
-
-                        if (!isFromFreeBot)
-                        {
-                            if (!isMentioned && urand(0, 4))
-                                return;
-                        }
-                        else
-                        {
-                            if (urand(0, 20 + 10 * isMentioned))
-                                return;
-                        }
                     }
-
-                    QueueChatResponse(ChatQueuedReply{msgtype, guid1.GetCounter(), guid2.GetCounter(), message,
-                                                      chanName, name,
-                                                      time(nullptr) + urand(inCombat ? 10 : 5, inCombat ? 25 : 15)});
-                    GetAiObjectContext()->GetValue<time_t>("last said", "chat")->Set(time(0) + urand(5, 25));
-                    return;
                 }
+
+                QueueChatResponse(ChatQueuedReply{msgtype, guid1.GetCounter(), chat.target.GetCounter(), message,
+                                                  chanName, name,
+                                                  time(nullptr) + urand(inCombat ? 10 : 5, inCombat ? 25 : 15)});
+                GetAiObjectContext()->GetValue<time_t>("last said", "chat")->Set(time(0) + urand(5, 25));
+                return;
             }
 
             return;
         }
         case SMSG_MOVE_KNOCK_BACK:  // handle knockbacks
         {
-            WorldPacket p(packet);
-            p.rpos(0);
-
-            ObjectGuid guid;
-            uint32 counter;
-            float vcos, vsin, horizontalSpeed, verticalSpeed = 0.f;
+            BotKnockBackEvent knockBack;
+            if (!knockBack.Read(packet))
+                return;
 
-            p >> guid.ReadAsPacked() >> counter >> vcos >> vsin >> horizontalSpeed >> verticalSpeed;
+            float const vcos = knockBack.vcos;
+            float const vsin = knockBack.vsin;
+            float horizontalSpeed = knockBack.horizontalSpeed;
+            float verticalSpeed = knockBack.verticalSpeed;
             if (horizontalSpeed <= 0.1f)
             {
                 horizontalSpeed = 0.11f;
@@ -1235,6 +1245,13 @@ void PlayerbotAI::HandleBotOutgoingPacket(WorldPacket const& packet)
             // */
             return;
         }
+        case SMSG_QUESTUPDATE_ADD_KILL:  // objective progress, rebuild the quest index on its next use
+        case SMSG_QUESTUPDATE_COMPLETE:
+        case SMSG_QUESTUPDATE_FAILED:
+        case SMSG_QUESTUPDATE_FAILEDTIMER:
+            questIndex.Invalidate();
+            botOutgoingPacketHandlers.AddPacket(packet);
+            return;
         default:
             botOutgoingPacketHandlers.AddPacket(packet);
     }
@@ -1427,6 +1444,7 @@ void PlayerbotAI::ChangeStrategy(std::string const names, BotState type)
         return;
 
     e->ChangeStrategy(names);
+    dbStoreDirty = true;
 }
 
 void PlayerbotAI::ClearStrategies(BotState type)
@@ -1436,6 +1454,7 @@ void PlayerbotAI::ClearStrategies(BotState type)
         return;
 
     e->removeAllStrategies();
+    dbStoreDirty = true;
 }
 
 std::vector<std::string> PlayerbotAI::GetStrategies(BotState type)
@@ -1657,6 +1676,8 @@ void PlayerbotAI::ResetStrategies(bool load)
     for (uint8 i = 0; i < BOT_STATE_MAX; i++)
         engines[i]->Init();
 
+    dbStoreDirty = true;
+
     // if (load)
     //     sPlayerbotDbStore->Load(this);
 }
@@ -3048,6 +3069,21 @@ bool PlayerbotAI::CanCastSpell(uint32 spellid, Unit* target, bool checkHasSpell,
         return false;
     }
 
+    // cheap power reject before any Spell is built, the probe below ignores power costs
+    if (!castItem && spellInfo->PowerType < MAX_POWERS && spellInfo->PowerType != POWER_RUNE)
+    {
+        int32 powerCost = spellInfo->CalcPowerCost(bot, spellInfo->GetSchoolMask());
+        if (powerCost > 0 && int32(bot->GetPower(Powers(spellInfo->PowerType))) < powerCost)
+        {
+            if (!sPlayerbotAIConfig->logInGroupOnly || (bot->GetGroup() && HasRealPlayerMaster()))
+            {
+                LOG_DEBUG("playerbots", "Not enough power - target name: {}, spellid: {}, bot name: {}",
+                          target->GetName(), spellid, bot->GetName());
+            }
+            return false;
+        }
+    }
+
     if ((bot->GetShapeshiftForm() == FORM_FLIGHT || bot->GetShapeshiftForm() == FORM_FLIGHT_EPIC) && !bot->IsInCombat())
     {
         if (!sPlayerbotAIConfig->logInGroupOnly || (bot->GetGroup() && HasRealPlayerMaster()))
@@ -3100,22 +3136,7 @@ bool PlayerbotAI::CanCastSpell(uint32 spellid, Unit* target, bool checkHasSpell,
         }
     }
 
-    Unit* oldSel = bot->GetSelectedUnit();
-    // TRIGGERED_IGNORE_POWER_AND_REAGENT_COST flag for not calling CheckPower in check
-    // which avoids buff charge to be ineffectively reduced (e.g. dk freezing fog for howling blast)
-    /// @TODO: Fix all calls to ApplySpellMod
-    Spell* spell = new Spell(bot, spellInfo, TRIGGERED_IGNORE_POWER_AND_REAGENT_COST);
-
-    spell->m_targets.SetUnitTarget(target);
-    spell->m_CastItem = castItem;
-    if (itemTarget == nullptr)
-    {
-        itemTarget = aiObjectContext->GetValue<Item*>("item for spell", spellid)->Get();
-        ;
-    }
-    spell->m_targets.SetItemTarget(itemTarget);
-    SpellCastResult result = spell->CheckCast(true);
-    delete spell;
+    SpellCastResult result = CheckCastCached(spellid, spellInfo, target, itemTarget, castItem);
 
     // if (!sPlayerbotAIConfig->logInGroupOnly || (bot->GetGroup() && HasRealPlayerMaster()))
     // {
@@ -3126,9 +3147,6 @@ bool PlayerbotAI::CanCastSpell(uint32 spellid, Unit* target, bool checkHasSpell,
     //     }
     // }
 
-    if (oldSel)
-        bot->SetSelection(oldSel->GetGUID());
-
     switch (result)
     {
         case SPELL_FAILED_NOT_INFRONT:
@@ -3151,6 +3169,53 @@ bool PlayerbotAI::CanCastSpell(uint32 spellid, Unit* target, bool checkHasSpell,
     }
 }
 
+SpellCastResult PlayerbotAI::CheckCastCached(uint32 spellid, SpellInfo const* spellInfo, Unit* target,
+                                             Item* itemTarget, Item* castItem)
+{
+    ++castCheckCounters.checks;
+
+    // explicit items are rare and depend on the caller, only the plain (spell, target) checks are remembered
+    bool const cacheable = !itemTarget && !castItem;
+    ObjectGuid const targetGuid = target->GetGUID();
+    if (cacheable)
+    {
+        for (CastCheckMemo const& memo : castCheckMemo)
+        {
+            if (memo.spellId == spellid && memo.target == targetGuid)
+            {
+                ++castCheckCounters.memoHits;
+                return memo.result;
+            }
+        }
+    }
+
+    Unit* oldSel = bot->GetSelectedUnit();
+    if (itemTarget == nullptr)
+        itemTarget = aiObjectContext->GetValue<Item*>("item for spell", spellid)->Get();
+
+    SpellCastResult result;
+    {
+        // TRIGGERED_IGNORE_POWER_AND_REAGENT_COST flag for not calling CheckPower in check
+        // which avoids buff charge to be ineffectively reduced (e.g. dk freezing fog for howling blast)
+        /// @TODO: Fix all calls to ApplySpellMod
+        Spell spell(bot, spellInfo, TRIGGERED_IGNORE_POWER_AND_REAGENT_COST);
+        ++castCheckCounters.spellProbes;
+
+        spell.m_targets.SetUnitTarget(target);
+        spell.m_CastItem = castItem;
+        spell.m_targets.SetItemTarget(itemTarget);
+        result = spell.CheckCast(true);
+    }
+
+    if (oldSel)
+        bot->SetSelection(oldSel->GetGUID());
+
+    if (cacheable)
+        castCheckMemo.push_back({spellid, targetGuid, result});
+
+    return result;
+}
+
 bool PlayerbotAI::CanCastSpell(uint32 spellid, GameObject* goTarget, bool checkHasSpell)
 {
     if (!spellid)
@@ -3276,6 +3341,9 @@ bool PlayerbotAI::CastSpell(uint32 spellId, Unit* target, Item* itemTarget)
         return false;
     }
 
+    // whatever gets cast changes cooldowns, power and auras the remembered checks were based on
+    castCheckMemo.clear();
+
     if (!target)
         target = bot;
 
@@ -3554,6 +3622,9 @@ bool PlayerbotAI::CastSpell(uint32 spellId, float x, float y, float z, Item* ite
     if (!spellId)
         return false;
 
+    // whatever gets cast changes cooldowns, power and auras the remembered checks were based on
+    castCheckMemo.clear();
+
     Pet* pet = bot->GetPet();
     SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellId);
     if (pet && pet->HasSpell(spellId))
@@ -4609,9 +4680,17 @@ void PlayerbotAI::RemoveShapeshift()
     // RemoveAura("tree of life");
 }
 
+uint32 PlayerbotAI::GetEquipGearScore(Player* player)
+{
+    if (PlayerbotGearScoreCache* cache = PlayerbotGearScoreCache::Get(player))
+        return cache->GetEquipGearScore(player);
+
+    return CalculateEquipGearScore(player);
+}
+
 // Mirrors Blizzard’s GetAverageItemLevel rules :
 // https://wowpedia.fandom.com/wiki/API_GetAverageItemLevel
-uint32 PlayerbotAI::GetEquipGearScore(Player* player)
+uint32 PlayerbotAI::CalculateEquipGearScore(Player* player)
 {
     constexpr uint8 TOTAL_SLOTS = 17;  // every slot except Body & Tabard
     uint32 sumLevel = 0;
@@ -4763,9 +4842,18 @@ uint32 PlayerbotAI::GetEquipGearScore(Player* player)
 }*/
 uint32 PlayerbotAI::GetMixedGearScore(Player* player, bool withBags, bool withBank, uint32 topN)
 {
+    if (PlayerbotGearScoreCache* cache = PlayerbotGearScoreCache::Get(player))
+        return cache->GetMixedGearScore(player, withBags, withBank, topN);
+
     std::vector<uint32> gearScore(EQUIPMENT_SLOT_END);
     uint32 twoHandScore = 0;
+    CollectMixedGearScore(player, withBags, withBank, gearScore, twoHandScore);
+    return ReduceMixedGearScore(gearScore, twoHandScore, topN);
+}
 
+void PlayerbotAI::CollectMixedGearScore(Player* player, bool withBags, bool withBank, std::vector<uint32>& gearScore,
+                                        uint32& twoHandScore)
+{
     for (uint8 i = EQUIPMENT_SLOT_START; i < EQUIPMENT_SLOT_END; ++i)
     {
         if (Item* item = player->GetItemByPos(INVENTORY_SLOT_BAG_0, i))
@@ -4819,6 +4907,10 @@ uint32 PlayerbotAI::GetMixedGearScore(Player* player, bool withBags, bool withBa
             }
         }
     }
+}
+
+uint32 PlayerbotAI::ReduceMixedGearScore(std::vector<uint32> gearScore, uint32 twoHandScore, uint32 topN)
+{
     if (!topN)
     {
         uint8 count = EQUIPMENT_SLOT_END - 2;  // ignore body and tabard slots
@@ -4851,16 +4943,13 @@ uint32 PlayerbotAI::GetMixedGearScore(Player* player, bool withBags, bool withBa
         gearScore[EQUIPMENT_SLOT_OFFHAND] = twoHandScore;
         gearScore[EQUIPMENT_SLOT_MAINHAND] = twoHandScore;
     }
-    std::vector<uint32> topGearScore;
-    for (uint8 i = EQUIPMENT_SLOT_START; i < EQUIPMENT_SLOT_END; ++i)
-    {
-        topGearScore.push_back(gearScore[i]);
-    }
-    std::sort(topGearScore.begin(), topGearScore.end(), [&](const uint32 lhs, const uint32 rhs) { return lhs > rhs; });
+    // only the best topN slots are needed, not a full sort
+    uint32 const count = std::min<uint32>(gearScore.size(), topN);
+    std::partial_sort(gearScore.begin(), gearScore.begin() + count, gearScore.end(), std::greater<uint32>());
     uint32 sum = 0;
-    for (uint32 i = 0; i < std::min((uint32)topGearScore.size(), topN); i++)
+    for (uint32 i = 0; i < count; i++)
     {
-        sum += topGearScore[i];
+        sum += gearScore[i];
     }
     return sum / topN;
 }
@@ -6386,7 +6475,45 @@ std::set<uint32> PlayerbotAI::GetCurrentIncompleteQuestIds()
     return result;
 }
 
+PlayerbotQuestIndex& PlayerbotAI::GetQuestIndex()
+{
+    questIndex.Update(bot);
+    return questIndex;
+}
+
+BotActivityTier PlayerbotAI::CalculateActivityTier()
+{
+    if (HasRealPlayerMaster())
+        return ACTIVITY_TIER_MASTER;
+
+    if (bot->InBattleground() || bot->InArena())
+        return ACTIVITY_TIER_BATTLEGROUND;
+
+    if (bot->IsInCombat() || currentState == BOT_STATE_COMBAT)
+        return ACTIVITY_TIER_COMBAT;
+
+    if (!bot->HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_RESTING))
+        return ACTIVITY_TIER_IDLE;
+
+    return ACTIVITY_TIER_RESTING;
+}
+
+float PlayerbotAI::GetTickScale() const { return sRandomPlayerbotMgr->GetTickScale(activityTier); }
+
+uint32 PlayerbotAI::GetIterationsPerTick(float tickScale)
+{
+    uint32 const iterations = sPlayerbotAIConfig->iterationsPerTick;
+    uint32 const floor = std::min(iterations, sPlayerbotAIConfig->tickScaleMinIterations);
+    return std::max(floor, static_cast<uint32>(iterations / tickScale));
+}
+
 uint32 PlayerbotAI::GetReactDelay()
+{
+    // under load the tick scale stretches the delay of the less important tiers
+    return static_cast<uint32>(GetBaseReactDelay() * GetTickScale());
+}
+
+uint32 PlayerbotAI::GetBaseReactDelay()
 {
     uint32 base = sPlayerbotAIConfig->reactDelay;  // Default 100(ms)
 
@@ -6595,6 +6722,15 @@ void PlayerbotAI::AddTimedEvent(std::function<void()> callback, uint32 delayMs)
     bot->m_Events.AddEvent(new LambdaEvent(std::move(callback)), bot->m_Events.CalculateTime(delayMs));
 }
 
+void PlayerbotAI::StartEngineCapture(uint32 ticks)
+{
+    for (uint8 i = 0; i < BOT_STATE_MAX; i++)
+    {
+        if (engines[i])
+            engines[i]->StartCapture(ticks);
+    }
+}
+
 void PlayerbotAI::EvaluateHealerDpsStrategy()
 {
     if (!IsHeal(bot, true))
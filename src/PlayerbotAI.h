@@ -6,6 +6,7 @@
 #ifndef _PLAYERBOT_PLAYERbotAI_H
 #define _PLAYERBOT_PLAYERbotAI_H
 
+#include <bitset>
 #include <queue>
 #include <stack>
 
@@ -20,7 +21,9 @@
 #include "NewRpgStrategy.h"
 #include "PlayerbotAIBase.h"
 #include "PlayerbotAIConfig.h"
+#include "PlayerbotQuestIndex.h"
 #include "PlayerbotSecurity.h"
+#include "PlayerbotStats.h"
 #include "PlayerbotTextMgr.h"
 #include "SpellAuras.h"
 #include "Util.h"
@@ -44,6 +47,7 @@ class WorldPosition;
 struct CreatureData;
 struct GameObjectData;
 
+enum BotActivityTier : uint8;
 enum StrategyType : uint32;
 
 enum HealingItemId
@@ -344,16 +348,23 @@ enum WARRIOR_TABS
     WARRIOR_TAB_PROTECTION,
 };
 
+#define PACKET_QUEUE_INITIAL_SIZE 16
+
+// Packets waiting for their trigger are kept in a ring of reused WorldPacket slots and handled in arrival order
 class PacketHandlingHelper
 {
 public:
     void AddHandler(uint16 opcode, std::string const handler);
     void Handle(ExternalEventHelper& helper);
     void AddPacket(WorldPacket const& packet);
+    bool IsHandled(uint16 opcode) const { return opcode < NUM_MSG_TYPES && handledOpcodes.test(opcode); }
 
 private:
     std::map<uint16, std::string> handlers;
-    std::stack<WorldPacket> queue;
+    std::bitset<NUM_MSG_TYPES> handledOpcodes;
+    std::vector<WorldPacket> queue;
+    uint32 queueHead = 0;
+    uint32 queueCount = 0;
 };
 
 class ChatCommandHolder
@@ -395,6 +406,7 @@ public:
     void HandleCommand(uint32 type, std::string const text, Player* fromPlayer);
     void QueueChatResponse(const ChatQueuedReply reply);
     void HandleBotOutgoingPacket(WorldPacket const& packet);
+    static bool IsDirectlyHandledOpcode(uint16 opcode);
     void HandleMasterIncomingPacket(WorldPacket const& packet);
     void HandleMasterOutgoingPacket(WorldPacket const& packet);
     void HandleTeleportAck();
@@ -413,6 +425,11 @@ public:
     bool HasStrategy(std::string const name, BotState type);
     BotState GetState() { return currentState; };
     void ResetStrategies(bool load = false);
+    // strategies changed since the last PlayerbotDbStore load/save
+    bool IsDbStoreDirty() const { return dbStoreDirty; }
+    void SetDbStoreDirty(bool dirty) { dbStoreDirty = dirty; }
+    size_t GetDbStoreValuesHash() const { return dbStoreValuesHash; }
+    void SetDbStoreValuesHash(size_t hash) { dbStoreValuesHash = hash; }
     void ReInitCurrentEngine();
     void Reset(bool full = false);
     void LeaveOrDisbandGroup();
@@ -520,9 +537,14 @@ public:
     bool IsInVehicle(bool canControl = false, bool canCast = false, bool canAttack = false, bool canTurn = false,
                      bool fixed = false);
 
+    // cached per player, see PlayerbotGearScoreCache
     uint32 GetEquipGearScore(Player* player);
     //uint32 GetEquipGearScore(Player* player, bool withBags, bool withBank);
     static uint32 GetMixedGearScore(Player* player, bool withBags, bool withBank, uint32 topN = 0);
+    static uint32 CalculateEquipGearScore(Player* player);
+    static void CollectMixedGearScore(Player* player, bool withBags, bool withBank, std::vector<uint32>& gearScore,
+                                      uint32& twoHandScore);
+    static uint32 ReduceMixedGearScore(std::vector<uint32> gearScore, uint32 twoHandScore, uint32 topN);
     bool HasSkill(SkillType skill);
     bool IsAllowedCommand(std::string const text);
     float GetRange(std::string const type);
@@ -591,32 +613,56 @@ public:
     bool HasItemInInventory(uint32 itemId);
     std::vector<std::pair<const Quest*, uint32>> GetCurrentQuestsRequiringItemId(uint32 itemId);
     uint32 GetReactDelay();
+    BotActivityTier GetActivityTier() const { return activityTier; }
+    float GetTickScale() const;
+    static uint32 GetIterationsPerTick(float tickScale);
 
     std::vector<const Quest*> GetAllCurrentQuests();
     std::vector<const Quest*> GetCurrentIncompleteQuests();
     std::set<uint32> GetAllCurrentQuestIds();
     std::set<uint32> GetCurrentIncompleteQuestIds();
+    // outstanding quest objectives of the bot, brought up to date on every call
+    PlayerbotQuestIndex& GetQuestIndex();
+    void OnItemStored(uint32 itemId) { questIndex.OnItemStored(itemId); }
     void PetFollow();
     static float GetItemScoreMultiplier(ItemQualities quality);
     static bool IsHealingSpell(uint32 spellFamilyName, flag96 spelFalimyFlags);
     static SpellFamilyNames Class2SpellFamilyName(uint8 cls);
     NewRpgInfo rpgInfo;
     NewRpgStatistic rpgStatistic;
+    PlayerbotStatsSample statsSample;
+    PlayerbotCastCheckCounters castCheckCounters;
     std::unordered_set<uint32> lowPriorityQuest;
     time_t bgReleaseAttemptTime = 0;
 
     // Schedules a callback to run once after <delayMs> milliseconds.
     void AddTimedEvent(std::function<void()> callback, uint32 delayMs);
+    // every engine of the bot records its next <ticks> decision loops, see EngineCapture
+    void StartEngineCapture(uint32 ticks);
 
 private:
     static void _fillGearScoreData(Player* player, Item* item, std::vector<uint32>* gearScore, uint32& twoHandScore,
                                    bool mixed = false);
     bool IsTellAllowed(PlayerbotSecurityLevel securityLevel = PLAYERBOT_SECURITY_ALLOW_ALL);
     void UpdateAIGroupMaster();
+    BotActivityTier CalculateActivityTier();
+    uint32 GetBaseReactDelay();
     Item* FindItemInInventory(std::function<bool(ItemTemplate const*)> checkItem) const;
     void HandleCommands();
     void HandleCommand(uint32 type, const std::string& text, Player& fromPlayer, const uint32 lang = LANG_UNIVERSAL);
+    SpellCastResult CheckCastCached(uint32 spellid, SpellInfo const* spellInfo, Unit* target, Item* itemTarget,
+                                    Item* castItem);
     bool _isBotInitializing = false;
+    BotActivityTier activityTier{};
+
+    struct CastCheckMemo
+    {
+        uint32 spellId;
+        ObjectGuid target;
+        SpellCastResult result;
+    };
+
+    std::vector<CastCheckMemo> castCheckMemo;
 
 protected:
     Player* bot;
@@ -627,6 +673,7 @@ protected:
     Engine* engines[BOT_STATE_MAX];
     BotState currentState;
     ChatHelper chatHelper;
+    PlayerbotQuestIndex questIndex;
     std::list<ChatCommandHolder> chatCommands;
     std::list<ChatQueuedReply> chatReplies;
     PacketHandlingHelper botOutgoingPacketHandlers;
@@ -643,6 +690,8 @@ protected:
     BotCheatMask cheatMask = BotCheatMask::none;
     Position jumpDestination = Position();
     uint32 nextTransportCheck = 0;
+    bool dbStoreDirty = true;
+    size_t dbStoreValuesHash = 0;
 };
 
 #endif
@@ -8,6 +8,7 @@
 
 #include "Define.h"
 #include "PlayerbotAIConfig.h"
+#include "PlayerbotGearScore.h"
 
 class PlayerbotAIBase
 {
@@ -22,10 +23,12 @@ public:
     virtual void UpdateAIInternal(uint32 elapsed, bool minimal = false) = 0;
     bool IsActive();
     bool IsBotAI() const;
+    PlayerbotGearScoreCache& GetGearScoreCache() { return gearScoreCache; }
 
 protected:
     uint32 nextAICheckDelay;
     class PerformanceMonitorOperation* totalPmo = nullptr;
+    PlayerbotGearScoreCache gearScoreCache;
 
 private:
     bool _isBotAI;
@@ -10,8 +10,10 @@
 #include "AnticipatoryThreatValue.h"
 #include "NewRpgInfo.h"
 #include "PathfindingBotManager.h"
+#include "PlayerbotCacheSnapshot.h"
 #include "PlayerbotDungeonSuggestionMgr.h"
 #include "PlayerbotFactory.h"
+#include "PlayerbotStartupLoader.h"
 #include "Playerbots.h"
 #include "RandomItemMgr.h"
 #include "RandomPlayerbotFactory.h"
@@ -401,7 +403,13 @@ bool PlayerbotAIConfig::Initialize()
     commandSeparator = sConfigMgr->GetOption<std::string>("AiPlayerbot.CommandSeparator", "\\\\");
 
     commandServerPort = sConfigMgr->GetOption<int32>("AiPlayerbot.CommandServerPort", 8888);
+    commandServerThreads = sConfigMgr->GetOption<int32>("AiPlayerbot.CommandServerThreads", 2);
+    startupLoaderThreads = sConfigMgr->GetOption<int32>("AiPlayerbot.StartupLoaderThreads", 4);
+    cacheSnapshotFile = sConfigMgr->GetOption<std::string>("AiPlayerbot.CacheSnapshotFile", "playerbots_cache.snapshot");
+    travelNodeStoreFile =
+        sConfigMgr->GetOption<std::string>("AiPlayerbot.TravelNodeStoreFile", "playerbots_travelnodes.bin");
     perfMonEnabled = sConfigMgr->GetOption<bool>("AiPlayerbot.PerfMonEnabled", false);
+    engineCaptureFile = sConfigMgr->GetOption<std::string>("AiPlayerbot.EngineCaptureFile", "engine_capture.log");
 
     useGroundMountAtMinLevel = sConfigMgr->GetOption<int32>("AiPlayerbot.UseGroundMountAtMinLevel", 20);
     useFastGroundMountAtMinLevel = sConfigMgr->GetOption<int32>("AiPlayerbot.UseFastGroundMountAtMinLevel", 40);
@@ -594,6 +602,16 @@ bool PlayerbotAIConfig::Initialize()
     botActiveAloneSmartScaleDiffLimitCeiling = sConfigMgr->GetOption<uint32>("AiPlayerbot.botActiveAloneSmartScaleDiffLimitCeiling", 200);
     botActiveAloneSmartScaleWhenMinLevel = sConfigMgr->GetOption<uint32>("AiPlayerbot.botActiveAloneSmartScaleWhenMinLevel", 1);
     botActiveAloneSmartScaleWhenMaxLevel = sConfigMgr->GetOption<uint32>("AiPlayerbot.botActiveAloneSmartScaleWhenMaxLevel", 80);
+    tickScale = sConfigMgr->GetOption<bool>("AiPlayerbot.TickScale", false);
+    tickScaleTargetDiff = sConfigMgr->GetOption<uint32>("AiPlayerbot.TickScaleTargetDiff", 50);
+    tickScaleTargetDiffEmpty = sConfigMgr->GetOption<uint32>("AiPlayerbot.TickScaleTargetDiffEmpty", 100);
+    tickScaleDeadband = sConfigMgr->GetOption<uint32>("AiPlayerbot.TickScaleDeadband", 5);
+    tickScaleMinIterations = sConfigMgr->GetOption<uint32>("AiPlayerbot.TickScaleMinIterations", 2);
+    tickScaleMaxStretch.clear();
+    LoadList<std::vector<uint32>>(sConfigMgr->GetOption<std::string>("AiPlayerbot.TickScaleMaxStretch", "100,200,300,500,800"),
+                                  tickScaleMaxStretch);
+    // tiers left out of the list are never stretched
+    tickScaleMaxStretch.resize(MAX_ACTIVITY_TIER, 100);
 
     randombotsWalkingRPG = sConfigMgr->GetOption<bool>("AiPlayerbot.RandombotsWalkingRPG", false);
     randombotsWalkingRPGInDoors = sConfigMgr->GetOption<bool>("AiPlayerbot.RandombotsWalkingRPG.InDoors", false);
@@ -659,24 +677,39 @@ bool PlayerbotAIConfig::Initialize()
     // Assign account types after accounts are created
     sRandomPlayerbotMgr->AssignAccountTypes();
 
+    // a valid snapshot replaces the database queries of the item and teleport caches
+    sPlayerbotCacheSnapshot->Open();
+
+    // independent caches are built in parallel, Run() returns once all of them are done
+    PlayerbotStartupLoader loader;
     if (sPlayerbotAIConfig->enabled)
     {
-        sRandomPlayerbotMgr->Init();
+        loader.AddStage("random bot caches", []() { sRandomPlayerbotMgr->Init(); });
     }
 
-    sRandomItemMgr->Init();
-    sRandomItemMgr->InitAfterAhBot();
-    sPlayerbotTextMgr->LoadBotTexts();
-    sPlayerbotTextMgr->LoadBotTextChance();
-    PlayerbotFactory::Init();
-
-    AiObjectContext::BuildAllSharedContexts();
+    sRandomItemMgr->AddStartupStages(loader);
+    loader.AddStage("bot texts",
+                    []()
+                    {
+                        sPlayerbotTextMgr->LoadBotTexts();
+                        sPlayerbotTextMgr->LoadBotTextChance();
+                    });
+    // test items are excluded from the factory caches
+    loader.AddStage("bot factory", []() { PlayerbotFactory::Init(); }, {"item info cache"});
+    loader.AddStage("shared contexts", []() { AiObjectContext::BuildAllSharedContexts(); });
 
     if (sPlayerbotAIConfig->randomBotSuggestDungeons)
     {
-        sPlayerbotDungeonSuggestionMgr->LoadDungeonSuggestions();
+        loader.AddStage("dungeon suggestions", []() { sPlayerbotDungeonSuggestionMgr->LoadDungeonSuggestions(); });
     }
 
+    loader.Run(startupLoaderThreads);
+
+    if (sPlayerbotCacheSnapshot->NeedsSave())
+        sPlayerbotCacheSnapshot->Save();
+    else
+        sPlayerbotCacheSnapshot->Close();
+
     excludedHunterPetFamilies.clear();
     LoadList<std::vector<uint32>>(sConfigMgr->GetOption<std::string>("AiPlayerbot.ExcludedHunterPetFamilies", ""), excludedHunterPetFamilies);
 
@@ -315,7 +315,12 @@ public:
     std::vector<worldBuff> worldBuffs;
 
     uint32 commandServerPort;
+    uint32 commandServerThreads;
+    uint32 startupLoaderThreads;
+    std::string cacheSnapshotFile;
+    std::string travelNodeStoreFile;
     bool perfMonEnabled;
+    std::string engineCaptureFile;
     bool summonWhenGroup;
     bool randomBotShowHelmet;
     bool randomBotShowCloak;
@@ -337,6 +342,12 @@ public:
     uint32 botActiveAloneSmartScaleDiffLimitCeiling;
     uint32 botActiveAloneSmartScaleWhenMinLevel;
     uint32 botActiveAloneSmartScaleWhenMaxLevel;
+    bool tickScale;
+    uint32 tickScaleTargetDiff;
+    uint32 tickScaleTargetDiffEmpty;
+    uint32 tickScaleDeadband;
+    uint32 tickScaleMinIterations;
+    std::vector<uint32> tickScaleMaxStretch;
 
     bool freeMethodLoot;
     int32 lootRollLevel;
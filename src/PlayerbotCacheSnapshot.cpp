@@ -0,0 +1,434 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "PlayerbotCacheSnapshot.h"
+
+#include <algorithm>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+#include "Config.h"
+#include "DatabaseEnv.h"
+#include "Playerbots.h"
+#include "RandomItemMgr.h"
+#include "RandomPlayerbotMgr.h"
+#include "Timer.h"
+#include "World.h"
+
+namespace
+{
+    char const SNAPSHOT_MAGIC[8] = {'P', 'B', 'C', 'A', 'C', 'H', 'E', '\0'};
+
+    struct SnapshotHeader
+    {
+        char magic[8];
+        uint32 version;
+        uint32 sectionCount;
+        uint64 key;
+    };
+
+    struct SnapshotSectionEntry
+    {
+        uint32 id;
+        uint32 padding;
+        uint64 offset;
+        uint64 size;
+    };
+
+    uint64 HashCombine(uint64 hash, std::string const& value)
+    {
+        // FNV-1a, stable across builds and platforms unlike std::hash
+        for (char c : value)
+        {
+            hash ^= uint8(c);
+            hash *= 1099511628211ULL;
+        }
+
+        hash ^= 0xFF;
+        hash *= 1099511628211ULL;
+        return hash;
+    }
+
+    // name, size and write time of the extracted client files, hashing their content would cost more than the
+    // caches. A patched dbc or re-extracted maps change the write time.
+    uint64 HashClientFiles(uint64 hash, std::string const& dir)
+    {
+        std::vector<std::string> files;
+        std::error_code error;
+        for (std::filesystem::directory_iterator it(dir, error), end; !error && it != end; it.increment(error))
+        {
+            std::error_code fileError;
+            if (!it->is_regular_file(fileError))
+                continue;
+
+            uintmax_t const size = it->file_size(fileError);
+            auto const writeTime = it->last_write_time(fileError).time_since_epoch().count();
+            files.push_back(fmt::format("{}:{}:{}", it->path().filename().string(), size, int64(writeTime)));
+        }
+
+        // directory order depends on the file system
+        std::sort(files.begin(), files.end());
+
+        hash = HashCombine(hash, dir + ":" + std::to_string(files.size()));
+        for (std::string const& file : files)
+            hash = HashCombine(hash, file);
+
+        return hash;
+    }
+}
+
+void PlayerbotCacheSnapshotWriter::BeginSection(uint32 id) { sections.push_back({id, {}}); }
+
+void PlayerbotCacheSnapshotWriter::PutRaw(void const* data, size_t size)
+{
+    ASSERT(!sections.empty());
+    std::vector<uint8>& buffer = sections.back().data;
+    uint8 const* bytes = static_cast<uint8 const*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+void PlayerbotCacheSnapshotWriter::PutIds(std::vector<uint32> const& ids)
+{
+    PutUInt32(ids.size());
+    if (!ids.empty())
+        PutRaw(ids.data(), ids.size() * sizeof(uint32));
+}
+
+void PlayerbotCacheSnapshotWriter::PutIdLists(SnapshotIdLists const& lists)
+{
+    PutUInt32(lists.size());
+    for (auto const& [key, ids] : lists)
+    {
+        PutUInt32(key);
+        PutIds(ids);
+    }
+}
+
+void PlayerbotCacheSnapshotWriter::PutIdTable(SnapshotIdTable const& table)
+{
+    PutUInt32(table.size());
+    for (auto const& [key, lists] : table)
+    {
+        PutUInt32(key);
+        PutIdLists(lists);
+    }
+}
+
+void PlayerbotCacheSnapshotWriter::PutString(std::string const& value)
+{
+    PutUInt32(value.size());
+    if (!value.empty())
+        PutRaw(value.data(), value.size());
+}
+
+bool PlayerbotCacheSnapshotWriter::Save(std::string const& path, uint32 version, uint64 key) const
+{
+    // written next to the target and renamed, a crash while saving never leaves a truncated snapshot behind
+    std::string const tempPath = path + ".tmp";
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out)
+        return false;
+
+    SnapshotHeader header;
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = version;
+    header.sectionCount = sections.size();
+    header.key = key;
+    out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+
+    uint64 offset = sizeof(SnapshotHeader) + sections.size() * sizeof(SnapshotSectionEntry);
+    for (Section const& section : sections)
+    {
+        SnapshotSectionEntry entry;
+        entry.id = section.id;
+        entry.padding = 0;
+        entry.offset = offset;
+        entry.size = section.data.size();
+        out.write(reinterpret_cast<char const*>(&entry), sizeof(entry));
+
+        // keep every section 8 byte aligned in the mapping
+        offset += (section.data.size() + 7) & ~uint64(7);
+    }
+
+    char const padding[8] = {};
+    for (Section const& section : sections)
+    {
+        out.write(reinterpret_cast<char const*>(section.data.data()), section.data.size());
+        out.write(padding, ((section.data.size() + 7) & ~size_t(7)) - section.data.size());
+    }
+
+    out.close();
+    if (!out)
+    {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    std::remove(path.c_str());
+    return std::rename(tempPath.c_str(), path.c_str()) == 0;
+}
+
+std::string PlayerbotCacheSnapshotSection::GetString()
+{
+    uint32 length = GetUInt32();
+    if (failed || pos + length > size)
+    {
+        failed = true;
+        return std::string();
+    }
+
+    std::string value(reinterpret_cast<char const*>(data + pos), length);
+    pos += length;
+    return value;
+}
+
+bool PlayerbotCacheSnapshotSection::GetIds(std::vector<uint32>& ids)
+{
+    uint32 count = GetUInt32();
+    if (failed || pos + size_t(count) * sizeof(uint32) > size)
+    {
+        failed = true;
+        return false;
+    }
+
+    ids.resize(count);
+    if (count)
+        GetRaw(ids.data(), count * sizeof(uint32));
+
+    return !failed;
+}
+
+bool PlayerbotCacheSnapshotSection::GetIdLists(SnapshotIdLists& lists)
+{
+    uint32 count = GetUInt32();
+    for (uint32 i = 0; i < count && !failed; ++i)
+    {
+        uint32 key = GetUInt32();
+        GetIds(lists[key]);
+    }
+
+    return !failed;
+}
+
+bool PlayerbotCacheSnapshotSection::GetIdTable(SnapshotIdTable& table)
+{
+    uint32 count = GetUInt32();
+    for (uint32 i = 0; i < count && !failed; ++i)
+    {
+        uint32 key = GetUInt32();
+        GetIdLists(table[key]);
+    }
+
+    return !failed;
+}
+
+struct PlayerbotSnapshotFile::Mapping
+{
+    boost::interprocess::file_mapping file;
+    boost::interprocess::mapped_region region;
+};
+
+PlayerbotSnapshotFile::PlayerbotSnapshotFile() {}
+
+PlayerbotSnapshotFile::~PlayerbotSnapshotFile() {}
+
+std::string PlayerbotSnapshotFile::ResolvePath(std::string const& fileName)
+{
+    if (fileName.empty() || fileName[0] == '/' || fileName.find(':') != std::string::npos)
+        return fileName;
+
+    std::string dataDir = sConfigMgr->GetOption<std::string>("DataDir", "./");
+    if (!dataDir.empty() && dataDir.back() != '/' && dataDir.back() != '\\')
+        dataDir += '/';
+
+    return dataDir + fileName;
+}
+
+SnapshotOpenResult PlayerbotSnapshotFile::Open(std::string const& path, uint32 version, uint64 key)
+{
+    Close();
+
+    std::ifstream probe(path, std::ios::binary);
+    if (!probe)
+        return SnapshotOpenResult::Missing;
+
+    probe.close();
+
+    try
+    {
+        std::unique_ptr<Mapping> fileMapping = std::make_unique<Mapping>();
+        fileMapping->file = boost::interprocess::file_mapping(path.c_str(), boost::interprocess::read_only);
+        fileMapping->region = boost::interprocess::mapped_region(fileMapping->file, boost::interprocess::read_only);
+        mapping = std::move(fileMapping);
+    }
+    catch (boost::interprocess::interprocess_exception const& e)
+    {
+        LOG_ERROR("playerbots", "Playerbots snapshot {} can not be mapped: {}", path, e.what());
+        return SnapshotOpenResult::Invalid;
+    }
+
+    uint8 const* data = static_cast<uint8 const*>(mapping->region.get_address());
+    size_t const size = mapping->region.get_size();
+
+    SnapshotHeader header;
+    if (size < sizeof(header))
+    {
+        Close();
+        return SnapshotOpenResult::Invalid;
+    }
+
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) ||
+        sizeof(header) + uint64(header.sectionCount) * sizeof(SnapshotSectionEntry) > size)
+    {
+        Close();
+        return SnapshotOpenResult::Invalid;
+    }
+
+    if (header.version != version || header.key != key)
+    {
+        Close();
+        return SnapshotOpenResult::Stale;
+    }
+
+    for (uint32 i = 0; i < header.sectionCount; ++i)
+    {
+        SnapshotSectionEntry entry;
+        std::memcpy(&entry, data + sizeof(header) + i * sizeof(entry), sizeof(entry));
+        if (entry.offset > size || entry.size > size - entry.offset)
+        {
+            Close();
+            return SnapshotOpenResult::Invalid;
+        }
+    }
+
+    return SnapshotOpenResult::Ok;
+}
+
+void PlayerbotSnapshotFile::Close() { mapping.reset(); }
+
+bool PlayerbotSnapshotFile::GetSection(uint32 id, PlayerbotCacheSnapshotSection& section) const
+{
+    if (!mapping)
+        return false;
+
+    uint8 const* data = static_cast<uint8 const*>(mapping->region.get_address());
+    SnapshotHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    for (uint32 i = 0; i < header.sectionCount; ++i)
+    {
+        SnapshotSectionEntry entry;
+        std::memcpy(&entry, data + sizeof(header) + i * sizeof(entry), sizeof(entry));
+        if (entry.id == id)
+        {
+            section = PlayerbotCacheSnapshotSection(data + entry.offset, entry.size);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+uint64 PlayerbotCacheSnapshot::ComputeKey() const
+{
+    uint64 hash = 14695981039346656037ULL;
+    hash = HashCombine(hash, std::to_string(CACHE_SNAPSHOT_VERSION));
+
+    // CHECKSUM TABLE is computed by the database server, far cheaper than the joins the caches are built from
+    if (QueryResult result = WorldDatabase.Query(
+            "CHECKSUM TABLE creature, creature_template, item_template, npc_vendor, quest_template, playercreateinfo"))
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            hash = HashCombine(hash, fields[0].Get<std::string>());
+            hash = HashCombine(hash, fields[1].IsNull() ? "" : std::to_string(fields[1].Get<uint64>()));
+        } while (result->NextRow());
+    }
+
+    // item caches read the dbc stores, the teleport cache the area ids of the map files
+    hash = HashClientFiles(hash, sWorld->GetDataPath() + "dbc");
+    hash = HashClientFiles(hash, sWorld->GetDataPath() + "maps");
+
+    hash = HashCombine(hash, std::to_string(sWorld->getIntConfig(CONFIG_MAX_PLAYER_LEVEL)));
+    hash = HashCombine(hash, std::to_string(sPlayerbotAIConfig->randomBotMaxLevel));
+    hash = HashCombine(hash, sPlayerbotAIConfig->randomBotMapsAsString);
+    hash = HashCombine(hash, std::to_string(sPlayerbotAIConfig->randomBotTeleLowerLevel));
+    hash = HashCombine(hash, std::to_string(sPlayerbotAIConfig->randomBotTeleHigherLevel));
+    hash = HashCombine(hash, std::to_string(sPlayerbotAIConfig->enableNewRpgStrategy));
+    for (auto const& [zoneId, bracket] : sPlayerbotAIConfig->zoneBrackets)
+        hash = HashCombine(hash, fmt::format("{}:{}-{}", zoneId, bracket.first, bracket.second));
+
+    return hash;
+}
+
+bool PlayerbotCacheSnapshot::Open()
+{
+    Close();
+
+    path = PlayerbotSnapshotFile::ResolvePath(sPlayerbotAIConfig->cacheSnapshotFile);
+    if (path.empty())
+        return false;
+
+    uint32 const startTime = getMSTime();
+    key = ComputeKey();
+
+    switch (file.Open(path, CACHE_SNAPSHOT_VERSION, key))
+    {
+        case SnapshotOpenResult::Ok:
+            LOG_INFO("server.loading", ">> Playerbots cache snapshot {} mapped in {} ms", path,
+                     GetMSTimeDiffToNow(startTime));
+            return true;
+        case SnapshotOpenResult::Missing:
+            LOG_INFO("server.loading", "Playerbots cache snapshot {} not found, caches will be built", path);
+            return false;
+        case SnapshotOpenResult::Stale:
+            LOG_INFO("server.loading", "Playerbots cache snapshot {} is stale, caches will be rebuilt", path);
+            return false;
+        default:
+            LOG_ERROR("playerbots", "Playerbots cache snapshot {} is damaged, caches will be rebuilt", path);
+            return false;
+    }
+}
+
+void PlayerbotCacheSnapshot::Close() { file.Close(); }
+
+bool PlayerbotCacheSnapshot::Save()
+{
+    if (path.empty())
+        return false;
+
+    uint32 const startTime = getMSTime();
+
+    PlayerbotCacheSnapshotWriter writer;
+    sRandomItemMgr->SaveSnapshot(writer);
+    if (sPlayerbotAIConfig->enabled)
+        sRandomPlayerbotMgr->SaveTeleportSnapshot(writer);
+
+    // the mapping of an old file must be released before it can be replaced
+    Close();
+    stale = false;
+    if (!writer.Save(path, CACHE_SNAPSHOT_VERSION, key))
+    {
+        LOG_ERROR("playerbots", "Playerbots cache snapshot {} could not be written", path);
+        return false;
+    }
+
+    LOG_INFO("server.loading", ">> Playerbots cache snapshot {} written in {} ms", path, GetMSTimeDiffToNow(startTime));
+    return true;
+}
+
+bool PlayerbotCacheSnapshot::Invalidate()
+{
+    Close();
+    if (path.empty())
+        return false;
+
+    return std::remove(path.c_str()) == 0;
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_PLAYERBOTCACHESNAPSHOT_H
+#define _PLAYERBOT_PLAYERBOTCACHESNAPSHOT_H
+
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Common.h"
+
+#define CACHE_SNAPSHOT_VERSION 1
+
+enum PlayerbotCacheSnapshotSectionId : uint32
+{
+    SNAPSHOT_SECTION_ITEM_FOR_TEST = 1,
+    SNAPSHOT_SECTION_EQUIP_CACHE = 2,
+    SNAPSHOT_SECTION_AMMO_CACHE = 3,
+    SNAPSHOT_SECTION_POTION_CACHE = 4,
+    SNAPSHOT_SECTION_FOOD_CACHE = 5,
+    SNAPSHOT_SECTION_TRADE_CACHE = 6,
+    SNAPSHOT_SECTION_TELEPORT_CACHE = 7,
+    SNAPSHOT_SECTION_STARTER_CACHE = 8,
+    SNAPSHOT_SECTION_BANKER_CACHE = 9
+};
+
+typedef std::map<uint32, std::map<uint32, std::vector<uint32>>> SnapshotIdTable;
+typedef std::map<uint32, std::vector<uint32>> SnapshotIdLists;
+
+// Builds the sections of a snapshot in memory, Save() writes header, section table and payload in one go
+// and replaces the target file atomically
+class PlayerbotCacheSnapshotWriter
+{
+public:
+    void BeginSection(uint32 id);
+
+    void PutUInt32(uint32 value) { PutRaw(&value, sizeof(value)); }
+    void PutFloat(float value) { PutRaw(&value, sizeof(value)); }
+    void PutString(std::string const& value);
+    void PutIds(std::vector<uint32> const& ids);
+    void PutIdLists(SnapshotIdLists const& lists);
+    void PutIdTable(SnapshotIdTable const& table);
+    void PutRaw(void const* data, size_t size);
+
+    bool Save(std::string const& path, uint32 version, uint64 key) const;
+
+private:
+    struct Section
+    {
+        uint32 id;
+        std::vector<uint8> data;
+    };
+
+    std::vector<Section> sections;
+};
+
+// Sequential view on one mapped section, reads past its end mark it as failed
+class PlayerbotCacheSnapshotSection
+{
+public:
+    PlayerbotCacheSnapshotSection() : data(nullptr), size(0) {}
+    PlayerbotCacheSnapshotSection(uint8 const* data, size_t size) : data(data), size(size) {}
+
+    uint32 GetUInt32()
+    {
+        uint32 value = 0;
+        GetRaw(&value, sizeof(value));
+        return value;
+    }
+
+    float GetFloat()
+    {
+        float value = 0.0f;
+        GetRaw(&value, sizeof(value));
+        return value;
+    }
+
+    std::string GetString();
+    bool GetIds(std::vector<uint32>& ids);
+    bool GetIdLists(SnapshotIdLists& lists);
+    bool GetIdTable(SnapshotIdTable& table);
+
+    void GetRaw(void* value, size_t length)
+    {
+        if (pos + length > size)
+        {
+            failed = true;
+            pos = size;
+            return;
+        }
+
+        std::memcpy(value, data + pos, length);
+        pos += length;
+    }
+
+    bool IsFailed() const { return failed; }
+
+private:
+    uint8 const* data;
+    size_t size;
+    size_t pos = 0;
+    bool failed = false;
+};
+
+enum class SnapshotOpenResult : uint8
+{
+    Ok,
+    Missing,
+    Stale,
+    Invalid
+};
+
+// Read-only memory mapping of a file written by PlayerbotCacheSnapshotWriter
+class PlayerbotSnapshotFile
+{
+public:
+    PlayerbotSnapshotFile();
+    ~PlayerbotSnapshotFile();
+
+    // only accepts files of the given version and key
+    SnapshotOpenResult Open(std::string const& path, uint32 version, uint64 key);
+    void Close();
+    bool IsOpen() const { return mapping != nullptr; }
+    bool GetSection(uint32 id, PlayerbotCacheSnapshotSection& section) const;
+
+    // relative names live in the data directory next to maps and vmaps
+    static std::string ResolvePath(std::string const& fileName);
+
+private:
+    struct Mapping;
+
+    std::unique_ptr<Mapping> mapping;
+};
+
+/**
+ * @brief Versioned binary snapshot of the playerbot startup caches
+ *
+ * The file is memory mapped and only accepted when its version and key match. The key hashes the world tables, the
+ * extracted dbc and map files and the config options the caches are built from, so edited world data, patched client
+ * data or changed options make the snapshot stale and the caches are rebuilt and written again.
+ */
+class PlayerbotCacheSnapshot
+{
+public:
+    PlayerbotCacheSnapshot() : key(0), stale(false) {}
+
+    static PlayerbotCacheSnapshot* instance()
+    {
+        static PlayerbotCacheSnapshot instance;
+        return &instance;
+    }
+
+    bool IsEnabled() const { return !path.empty(); }
+    std::string const& GetPath() const { return path; }
+
+    // computes the key and maps the file, false when there is no valid snapshot
+    bool Open();
+    void Close();
+    bool IsLoaded() const { return file.IsOpen(); }
+    bool GetSection(uint32 id, PlayerbotCacheSnapshotSection& section) const
+    {
+        return file.GetSection(id, section);
+    }
+    // a consumer could not use its sections and built its caches itself
+    void MarkStale() { stale = true; }
+    bool NeedsSave() const { return IsEnabled() && (!IsLoaded() || stale); }
+
+    // called after the caches were built from the database
+    bool Save();
+    // removes the file, the next start rebuilds the caches and writes a new snapshot
+    bool Invalidate();
+
+private:
+    uint64 ComputeKey() const;
+
+    std::string path;
+    PlayerbotSnapshotFile file;
+    uint64 key;
+    std::atomic<bool> stale;
+};
+
+#define sPlayerbotCacheSnapshot PlayerbotCacheSnapshot::instance()
+
+#endif
@@ -6,95 +6,304 @@
 #include "PlayerbotCommandServer.h"
 
 #include <boost/asio.hpp>
-#include <boost/bind.hpp>
-#include <boost/smart_ptr.hpp>
-#include <boost/thread/thread.hpp>
-#include <cstdlib>
-#include <iostream>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
 
-#include "IoContext.h"
+#include "PlayerbotOperation.h"
+#include "PlayerbotWorldThreadProcessor.h"
 #include "Playerbots.h"
 
 using boost::asio::ip::tcp;
-typedef boost::shared_ptr<tcp::socket> socket_ptr;
 
-bool ReadLine(socket_ptr sock, std::string* buffer, std::string* line)
+#define COMMAND_SERVER_READ_BUFFER_SIZE (64 * 1024)
+#define COMMAND_SERVER_MAX_PENDING_BATCHES 8
+
+class PlayerbotCommandSession : public std::enable_shared_from_this<PlayerbotCommandSession>
 {
-    // Do the real reading from fd until buffer has '\n'.
-    std::string::iterator pos;
-    while ((pos = find(buffer->begin(), buffer->end(), '\n')) == buffer->end())
+public:
+    PlayerbotCommandSession(tcp::socket socket)
+        : socket(std::move(socket)),
+          strand(boost::asio::make_strand(this->socket.get_executor())),
+          readBuffer(COMMAND_SERVER_READ_BUFFER_SIZE),
+          readLength(0),
+          pendingBatches(0),
+          writing(false),
+          readPaused(false)
     {
-        char buf[1025];
-        boost::system::error_code error;
-        size_t n = sock->read_some(boost::asio::buffer(buf), error);
-        if (n == -1 || error == boost::asio::error::eof)
-            return false;
-        else if (error)
-            throw boost::system::system_error(error);  // Some other error.
+    }
 
-        buf[n] = 0;
-        *buffer += buf;
+    void Start()
+    {
+        boost::asio::dispatch(strand, [self = shared_from_this()]() { self->DoRead(); });
     }
 
-    *line = std::string(buffer->begin(), pos);
-    *buffer = std::string(pos + 1, buffer->end());
-    return true;
-}
+    // called from the world thread once a batch has been handled
+    void Deliver(std::string responses)
+    {
+        boost::asio::post(strand,
+                          [self = shared_from_this(), responses = std::move(responses)]() mutable
+                          {
+                              self->writeQueue.push_back(std::move(responses));
+                              --self->pendingBatches;
+                              if (!self->writing)
+                                  self->DoWrite();
+
+                              if (self->readPaused && self->pendingBatches < COMMAND_SERVER_MAX_PENDING_BATCHES)
+                              {
+                                  self->readPaused = false;
+                                  self->DoRead();
+                              }
+                          });
+    }
+
+private:
+    void DoRead()
+    {
+        if (!socket.is_open())
+            return;
+
+        // throttle clients that pipeline faster than the world thread drains
+        if (pendingBatches >= COMMAND_SERVER_MAX_PENDING_BATCHES)
+        {
+            readPaused = true;
+            return;
+        }
+
+        socket.async_read_some(
+            boost::asio::buffer(readBuffer.data() + readLength, readBuffer.size() - readLength),
+            boost::asio::bind_executor(strand,
+                                       [self = shared_from_this()](boost::system::error_code const& error, size_t length)
+                                       { self->OnRead(error, length); }));
+    }
+
+    void OnRead(boost::system::error_code const& error, size_t length)
+    {
+        if (error)
+        {
+            Close();
+            return;
+        }
+
+        readLength += length;
+
+        // frame requests in place, only the complete lines are copied out for the world thread
+        std::vector<std::string> requests;
+        char const* data = readBuffer.data();
+        size_t lineStart = 0;
+        while (char const* newline =
+                   static_cast<char const*>(std::memchr(data + lineStart, '\n', readLength - lineStart)))
+        {
+            size_t lineEnd = newline - data;
+            std::string_view line(data + lineStart, lineEnd - lineStart);
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+
+            requests.emplace_back(line);
+            lineStart = lineEnd + 1;
+        }
+
+        if (lineStart)
+        {
+            std::memmove(readBuffer.data(), data + lineStart, readLength - lineStart);
+            readLength -= lineStart;
+        }
+        else if (readLength == readBuffer.size())
+        {
+            LOG_ERROR("playerbots", "Command server: request exceeds {} bytes, closing connection",
+                      readBuffer.size());
+            Close();
+            return;
+        }
+
+        if (!requests.empty())
+            QueueBatch(std::move(requests));
+
+        DoRead();
+    }
+
+    void QueueBatch(std::vector<std::string> requests);
+
+    void DoWrite()
+    {
+        if (writeQueue.empty() || !socket.is_open())
+        {
+            writing = false;
+            return;
+        }
+
+        writing = true;
+        boost::asio::async_write(
+            socket, boost::asio::buffer(writeQueue.front()),
+            boost::asio::bind_executor(strand,
+                                       [self = shared_from_this()](boost::system::error_code const& error, size_t)
+                                       {
+                                           if (error)
+                                           {
+                                               self->Close();
+                                               return;
+                                           }
+
+                                           self->writeQueue.pop_front();
+                                           self->DoWrite();
+                                       }));
+    }
 
-void session(socket_ptr sock)
+    void Close()
+    {
+        boost::system::error_code ignored;
+        socket.shutdown(tcp::socket::shutdown_both, ignored);
+        socket.close(ignored);
+        writeQueue.clear();
+        writing = false;
+    }
+
+    tcp::socket socket;
+    boost::asio::strand<tcp::socket::executor_type> strand;
+    std::vector<char> readBuffer;
+    size_t readLength;
+    std::deque<std::string> writeQueue;
+    uint32 pendingBatches;
+    bool writing;
+    bool readPaused;
+};
+
+// Runs every request read from a connection in one go on the world thread. Every batch answers exactly once: a
+// batch that is rejected, dropped or fails still answers one line per request when it is destroyed.
+class RemoteCommandBatchOperation : public PlayerbotOperation
 {
-    try
+public:
+    RemoteCommandBatchOperation(std::shared_ptr<PlayerbotCommandSession> session, std::vector<std::string> requests)
+        : m_session(std::move(session)), m_requests(std::move(requests)), m_failure("server busy"), m_delivered(false)
     {
-        std::string buffer, request;
-        while (ReadLine(sock, &buffer, &request))
+    }
+
+    ~RemoteCommandBatchOperation() override
+    {
+        if (m_delivered)
+            return;
+
+        std::string responses;
+        for (size_t i = 0; i < m_requests.size(); ++i)
         {
-            std::string const response = sRandomPlayerbotMgr->HandleRemoteCommand(request) + "\n";
-            boost::asio::write(*sock, boost::asio::buffer(response.c_str(), response.size()));
-            request = "";
+            responses += m_failure;
+            responses += '\n';
         }
+
+        m_session->Deliver(std::move(responses));
     }
-    catch (std::exception& e)
+
+    bool Execute() override
     {
-        LOG_ERROR("playerbots", "{}", e.what());
+        // reached the world thread, anything going wrong from here on is a failed command
+        m_failure = "command failed";
+
+        std::string responses;
+        for (std::string const& request : m_requests)
+        {
+            responses += sRandomPlayerbotMgr->HandleRemoteCommand(request);
+            responses += '\n';
+        }
+
+        m_delivered = true;
+        m_session->Deliver(std::move(responses));
+        return true;
     }
+
+    uint32 GetPriority() const override { return 0; }
+
+    std::string GetName() const override { return "RemoteCommandBatchOperation"; }
+
+private:
+    std::shared_ptr<PlayerbotCommandSession> m_session;
+    std::vector<std::string> m_requests;
+    std::string m_failure;
+    bool m_delivered;
+};
+
+void PlayerbotCommandSession::QueueBatch(std::vector<std::string> requests)
+{
+    ++pendingBatches;
+
+    // a full world queue destroys the batch, which then answers "server busy" for each request
+    sPlayerbotWorldProcessor->QueueOperation(
+        std::make_unique<RemoteCommandBatchOperation>(shared_from_this(), std::move(requests)));
 }
 
-void server(Acore::Asio::IoContext& io_service, short port)
+class PlayerbotCommandListener
 {
-    tcp::acceptor a(io_service, tcp::endpoint(tcp::v4(), port));
-    for (;;)
+public:
+    PlayerbotCommandListener(boost::asio::io_context& ioContext, uint16 port)
+        : acceptor(ioContext, tcp::endpoint(tcp::v4(), port))
     {
-        socket_ptr sock(new tcp::socket(io_service));
-        a.accept(*sock);
-        boost::thread t(boost::bind(session, sock));
     }
-}
 
-void Run()
+    void DoAccept()
+    {
+        acceptor.async_accept(
+            [this](boost::system::error_code const& error, tcp::socket socket)
+            {
+                if (!error)
+                    std::make_shared<PlayerbotCommandSession>(std::move(socket))->Start();
+                else
+                    LOG_ERROR("playerbots", "Command server: accept failed: {}", error.message());
+
+                DoAccept();
+            });
+    }
+
+private:
+    tcp::acceptor acceptor;
+};
+
+void PlayerbotCommandServer::Start()
 {
     if (!sPlayerbotAIConfig->commandServerPort)
     {
         return;
     }
 
-    std::ostringstream s;
-    s << "Starting Playerbots Command Server on port " << sPlayerbotAIConfig->commandServerPort;
-    LOG_INFO("playerbots", "{}", s.str().c_str());
+    uint32 threads = std::max<uint32>(1, sPlayerbotAIConfig->commandServerThreads);
+    LOG_INFO("playerbots", "Starting Playerbots Command Server on port {} ({} threads)",
+             sPlayerbotAIConfig->commandServerPort, threads);
+
+    // intentionally never destroyed, the detached io threads may still be running at process exit
+    boost::asio::io_context* ioContext = new boost::asio::io_context(threads);
 
     try
     {
-        Acore::Asio::IoContext io_service;
-        server(io_service, sPlayerbotAIConfig->commandServerPort);
+        PlayerbotCommandListener* listener =
+            new PlayerbotCommandListener(*ioContext, sPlayerbotAIConfig->commandServerPort);
+        listener->DoAccept();
     }
-
     catch (std::exception& e)
     {
         LOG_ERROR("playerbots", "{}", e.what());
+        return;
     }
-}
 
-void PlayerbotCommandServer::Start()
-{
-    std::thread serverThread(Run);
-    serverThread.detach();
+    for (uint32 i = 0; i < threads; ++i)
+    {
+        std::thread serverThread(
+            [ioContext]()
+            {
+                auto work = boost::asio::make_work_guard(*ioContext);
+                for (;;)
+                {
+                    try
+                    {
+                        ioContext->run();
+                        break;
+                    }
+                    catch (std::exception& e)
+                    {
+                        LOG_ERROR("playerbots", "{}", e.what());
+                    }
+                }
+            });
+        serverThread.detach();
+    }
 }
@@ -6,6 +6,14 @@
 #ifndef _PLAYERBOT_PLAYERBOTCOMMANDSERVER_H
 #define _PLAYERBOT_PLAYERBOTCOMMANDSERVER_H
 
+/**
+ * @brief Line based remote command server for external tooling
+ *
+ * Connections are served asynchronously by a small fixed pool of io threads. Every read is split into
+ * newline terminated requests which are handed to the world thread as one batch through
+ * PlayerbotWorldThreadProcessor, so RandomPlayerbotMgr::HandleRemoteCommand never runs concurrently with
+ * the world update. Clients may pipeline requests; responses come back in request order, one line each.
+ */
 class PlayerbotCommandServer
 {
 public:
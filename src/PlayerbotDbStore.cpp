@@ -43,6 +43,9 @@ void PlayerbotDbStore::Load(PlayerbotAI* botAI)
         } while (result->NextRow());
 
         botAI->GetAiObjectContext()->Load(values);
+
+        botAI->SetDbStoreValuesHash(HashValues(botAI->GetAiObjectContext()->Save()));
+        botAI->SetDbStoreDirty(false);
     }
 }
 
@@ -50,22 +53,46 @@ void PlayerbotDbStore::Save(PlayerbotAI* botAI)
 {
     ObjectGuid::LowType guid = botAI->GetBot()->GetGUID().GetCounter();
 
-    Reset(botAI);
+    // strategy changes flag the bot dirty, values are compared by content since most are modified in place
+    std::vector<std::string> data = botAI->GetAiObjectContext()->Save();
+    size_t valuesHash = HashValues(data);
+    if (!botAI->IsDbStoreDirty() && valuesHash == botAI->GetDbStoreValuesHash())
+    {
+        ++skippedCount;
+        return;
+    }
+
+    data.reserve(data.size() + 3);
+    std::vector<std::string> keys(data.size(), "value");
+    keys.push_back("co");
+    data.push_back(FormatStrategies("co", botAI->GetStrategies(BOT_STATE_COMBAT)));
+    keys.push_back("nc");
+    data.push_back(FormatStrategies("nc", botAI->GetStrategies(BOT_STATE_NON_COMBAT)));
+    keys.push_back("dead");
+    data.push_back(FormatStrategies("dead", botAI->GetStrategies(BOT_STATE_DEAD)));
+
+    std::ostringstream query;
+    query << "INSERT INTO playerbots_db_store (`guid`, `key`, `value`) VALUES ";
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        std::string value = data[i];
+        PlayerbotsDatabase.EscapeString(value);
+        query << (i ? "," : "") << "(" << guid << ",'" << keys[i] << "','" << value << "')";
+    }
+
+    PlayerbotsDatabaseTransaction trans = PlayerbotsDatabase.BeginTransaction();
 
     PlayerbotsDatabasePreparedStatement* deleteStatement =
         PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_DEL_DB_STORE);
     deleteStatement->SetData(0, guid);
-    PlayerbotsDatabase.Execute(deleteStatement);
+    trans->Append(deleteStatement);
+    trans->Append(query.str().c_str());
 
-    std::vector<std::string> data = botAI->GetAiObjectContext()->Save();
-    for (std::vector<std::string>::iterator i = data.begin(); i != data.end(); ++i)
-    {
-        SaveValue(guid, "value", *i);
-    }
+    PlayerbotsDatabase.CommitTransaction(trans);
 
-    SaveValue(guid, "co", FormatStrategies("co", botAI->GetStrategies(BOT_STATE_COMBAT)));
-    SaveValue(guid, "nc", FormatStrategies("nc", botAI->GetStrategies(BOT_STATE_NON_COMBAT)));
-    SaveValue(guid, "dead", FormatStrategies("dead", botAI->GetStrategies(BOT_STATE_DEAD)));
+    botAI->SetDbStoreValuesHash(valuesHash);
+    botAI->SetDbStoreDirty(false);
+    ++savedCount;
 }
 
 std::string const PlayerbotDbStore::FormatStrategies(std::string const type, std::vector<std::string> strategies)
@@ -85,13 +112,21 @@ void PlayerbotDbStore::Reset(PlayerbotAI* botAI)
     PlayerbotsDatabasePreparedStatement* stmt = PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_DEL_DB_STORE);
     stmt->SetData(0, guid);
     PlayerbotsDatabase.Execute(stmt);
+
+    botAI->SetDbStoreDirty(true);
 }
 
-void PlayerbotDbStore::SaveValue(uint32 guid, std::string const key, std::string const value)
+void PlayerbotDbStore::ResetStats()
 {
-    PlayerbotsDatabasePreparedStatement* stmt = PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_INS_DB_STORE);
-    stmt->SetData(0, guid);
-    stmt->SetData(1, key);
-    stmt->SetData(2, value);
-    PlayerbotsDatabase.Execute(stmt);
+    savedCount = 0;
+    skippedCount = 0;
+}
+
+size_t PlayerbotDbStore::HashValues(std::vector<std::string> const& values)
+{
+    size_t hash = values.size();
+    for (std::string const& value : values)
+        hash ^= std::hash<std::string>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+
+    return hash;
 }
@@ -6,6 +6,7 @@
 #ifndef _PLAYERBOT_PLAYERBOTDBSTORE_H
 #define _PLAYERBOT_PLAYERBOTDBSTORE_H
 
+#include <atomic>
 #include <vector>
 
 #include "Common.h"
@@ -15,7 +16,7 @@ class PlayerbotAI;
 class PlayerbotDbStore
 {
 public:
-    PlayerbotDbStore() {}
+    PlayerbotDbStore() : savedCount(0), skippedCount(0) {}
     virtual ~PlayerbotDbStore() {}
     static PlayerbotDbStore* instance()
     {
@@ -27,9 +28,17 @@ public:
     void Load(PlayerbotAI* botAI);
     void Reset(PlayerbotAI* botAI);
 
+    // saves written / skipped as unchanged since the last ResetStats()
+    uint32 GetSavedCount() const { return savedCount; }
+    uint32 GetSkippedCount() const { return skippedCount; }
+    void ResetStats();
+
 private:
-    void SaveValue(uint32 guid, std::string const key, std::string const value);
     std::string const FormatStrategies(std::string const type, std::vector<std::string> strategies);
+    static size_t HashValues(std::vector<std::string> const& values);
+
+    std::atomic<uint32> savedCount;
+    std::atomic<uint32> skippedCount;
 };
 
 #define sPlayerbotDbStore PlayerbotDbStore::instance()
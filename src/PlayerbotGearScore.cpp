@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "PlayerbotGearScore.h"
+
+#include "Item.h"
+#include "Player.h"
+#include "PlayerbotAI.h"
+#include "PlayerbotMgr.h"
+#include "Playerbots.h"
+#include "Timer.h"
+
+static_assert(EQUIPMENT_SLOT_END == 19, "PlayerbotGearScoreCache::EQUIP_SLOTS out of date");
+
+static constexpr uint32 SPELL_TITAN_GRIP = 49152;
+
+// safety net for changes without an event, the events keep the scores current in between
+static constexpr uint32 EQUIP_GEAR_SCORE_RESYNC = 60 * IN_MILLISECONDS;
+static constexpr uint32 MIXED_GEAR_SCORE_RESYNC = 10 * IN_MILLISECONDS;
+
+PlayerbotGearScoreCache* PlayerbotGearScoreCache::Get(Player* player)
+{
+    if (!player)
+        return nullptr;
+
+    if (PlayerbotAI* botAI = GET_PLAYERBOT_AI(player))
+        return &botAI->GetGearScoreCache();
+
+    if (PlayerbotMgr* playerbotMgr = GET_PLAYERBOT_MGR(player))
+        return &playerbotMgr->GetGearScoreCache();
+
+    return nullptr;
+}
+
+void PlayerbotGearScoreCache::RebuildEquipment(Player* player)
+{
+    for (uint8 slot = EQUIPMENT_SLOT_START; slot < EQUIPMENT_SLOT_END; ++slot)
+    {
+        Item* item = player->GetItemByPos(INVENTORY_SLOT_BAG_0, slot);
+        equipLevels[slot] = item ? item->GetTemplate()->ItemLevel : 0;
+        if (slot == EQUIPMENT_SLOT_MAINHAND)
+            mainHandType = item ? item->GetTemplate()->InventoryType : 0;
+        else if (slot == EQUIPMENT_SLOT_OFFHAND)
+            hasOffHand = item != nullptr;
+    }
+
+    equipBuiltAt = getMSTime();
+    equipValid = true;
+}
+
+// Same rules as PlayerbotAI::CalculateEquipGearScore, on the cached item levels
+uint32 PlayerbotGearScoreCache::GetEquipGearScore(Player* player)
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    if (!equipValid || GetMSTimeDiffToNow(equipBuiltAt) > EQUIP_GEAR_SCORE_RESYNC)
+        RebuildEquipment(player);
+
+    constexpr uint8 TOTAL_SLOTS = 17;  // every slot except Body & Tabard
+
+    bool ignoreOffhand = false;
+    if (mainHandType)
+        ignoreOffhand = mainHandType == INVTYPE_2HWEAPON && !player->HasAura(SPELL_TITAN_GRIP);
+    else if (!hasOffHand)
+        ignoreOffhand = true;
+
+    uint32 sumLevel = 0;
+    for (uint8 slot = EQUIPMENT_SLOT_START; slot < EQUIPMENT_SLOT_END; ++slot)
+    {
+        if (slot == EQUIPMENT_SLOT_BODY || slot == EQUIPMENT_SLOT_TABARD)
+            continue;
+
+        if (ignoreOffhand && slot == EQUIPMENT_SLOT_OFFHAND)
+            continue;
+
+        sumLevel += equipLevels[slot];
+    }
+
+    return sumLevel / (ignoreOffhand ? TOTAL_SLOTS - 1 : TOTAL_SLOTS);
+}
+
+uint32 PlayerbotGearScoreCache::GetMixedGearScore(Player* player, bool withBags, bool withBank, uint32 topN)
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    MixedScores& scores = mixedScores[uint8(withBags) | (uint8(withBank) << 1)];
+    if (!scores.valid || GetMSTimeDiffToNow(scores.builtAt) > MIXED_GEAR_SCORE_RESYNC)
+    {
+        scores.gearScore.assign(EQUIPMENT_SLOT_END, 0);
+        scores.twoHandScore = 0;
+        PlayerbotAI::CollectMixedGearScore(player, withBags, withBank, scores.gearScore, scores.twoHandScore);
+        scores.builtAt = getMSTime();
+        scores.valid = true;
+    }
+
+    return PlayerbotAI::ReduceMixedGearScore(scores.gearScore, scores.twoHandScore, topN);
+}
+
+void PlayerbotGearScoreCache::OnEquip(Item* item, uint8 slot)
+{
+    if (slot >= EQUIPMENT_SLOT_END)
+        return;
+
+    std::lock_guard<std::mutex> guard(lock);
+
+    // a valid cache only needs the one slot, an invalid one is rebuilt on the next read anyway
+    if (equipValid)
+    {
+        equipLevels[slot] = item ? item->GetTemplate()->ItemLevel : 0;
+        if (slot == EQUIPMENT_SLOT_MAINHAND)
+            mainHandType = item ? item->GetTemplate()->InventoryType : 0;
+        else if (slot == EQUIPMENT_SLOT_OFFHAND)
+            hasOffHand = item != nullptr;
+    }
+
+    // equipped items count for every mixed variant
+    InvalidateMixedScores();
+}
+
+void PlayerbotGearScoreCache::OnEquipmentChanged()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    equipValid = false;
+    InvalidateMixedScores();
+}
+
+void PlayerbotGearScoreCache::OnInventoryChanged()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    InvalidateMixedScores();
+}
+
+void PlayerbotGearScoreCache::InvalidateMixedScores()
+{
+    for (MixedScores& scores : mixedScores)
+        scores.valid = false;
+}
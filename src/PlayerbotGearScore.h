@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_PLAYERBOTGEARSCORE_H
+#define _PLAYERBOT_PLAYERBOTGEARSCORE_H
+
+#include <array>
+#include <mutex>
+#include <vector>
+
+#include "Define.h"
+
+class Item;
+class Player;
+
+/**
+ * @brief Per player gear score, kept up to date from equipment and inventory events
+ *
+ * Equipping an item updates its slot in place, unequipping or new items only mark the affected scores dirty so the
+ * next read rebuilds them once instead of every call walking the equipment, bags and bank. The scores are also
+ * rebuilt after a while to pick up changes no event reports (destroyed or banked items).
+ *
+ * Other bots read the scores of their group members from their own map threads, so every access takes the lock.
+ */
+class PlayerbotGearScoreCache
+{
+public:
+    // the cache of bots and of players owning bots, nullptr for everyone else
+    static PlayerbotGearScoreCache* Get(Player* player);
+
+    uint32 GetEquipGearScore(Player* player);
+    uint32 GetMixedGearScore(Player* player, bool withBags, bool withBank, uint32 topN);
+
+    void OnEquip(Item* item, uint8 slot);
+    void OnEquipmentChanged();
+    void OnInventoryChanged();
+
+private:
+    struct MixedScores
+    {
+        std::vector<uint32> gearScore;
+        uint32 twoHandScore = 0;
+        uint32 builtAt = 0;
+        bool valid = false;
+    };
+
+    // EQUIPMENT_SLOT_END, Player.h is too heavy for PlayerbotAIBase.h
+    static constexpr uint8 EQUIP_SLOTS = 19;
+
+    void RebuildEquipment(Player* player);
+    void InvalidateMixedScores();
+
+    std::mutex lock;
+
+    std::array<uint32, EQUIP_SLOTS> equipLevels = {};
+    // INVTYPE_NON_EQUIP when the main hand is empty
+    uint32 mainHandType = 0;
+    bool hasOffHand = false;
+    uint32 equipBuiltAt = 0;
+    bool equipValid = false;
+    // indexed by withBags | withBank << 1
+    std::array<MixedScores, 4> mixedScores;
+};
+
+#endif
@@ -256,6 +256,10 @@ void PlayerbotHolder::LogoutAllBots()
     }
     */
 
+    uint32 oldMSTime = getMSTime();
+    sPlayerbotDbStore->ResetStats();
+
+    uint32 count = 0;
     PlayerBotMap bots = playerBots;
     for (auto& itr : bots)
     {
@@ -268,7 +272,13 @@ void PlayerbotHolder::LogoutAllBots()
             continue;
 
         LogoutPlayerBot(bot->GetGUID());
+        ++count;
     }
+
+    if (count)
+        LOG_INFO("playerbots", "{} bots logged out in {} ms (db store: {} saved, {} unchanged)", count,
+                 GetMSTimeDiffToNow(oldMSTime), sPlayerbotDbStore->GetSavedCount(),
+                 sPlayerbotDbStore->GetSkippedCount());
 }
 
 void PlayerbotMgr::CancelLogout()
@@ -1474,7 +1484,7 @@ PlayerbotMgr::PlayerbotMgr(Player* const master) : PlayerbotHolder(), master(mas
 PlayerbotMgr::~PlayerbotMgr()
 {
     if (master)
-        sPlayerbotsMgr->RemovePlayerBotData(master->GetGUID(), false);
+        sPlayerbotsMgr->RemovePlayerBotData(master->GetGUID(), false, this);
 }
 
 void PlayerbotMgr::UpdateAIInternal(uint32 elapsed, bool /*minimal*/)
@@ -1709,50 +1719,29 @@ void PlayerbotsMgr::AddPlayerbotData(Player* player, bool isBotAI)
     {
         return;
     }
-    // If the guid already exists in the map, remove it
+    // If the guid already exists in the registry, it is replaced
 
     if (!isBotAI)
     {
-        std::unordered_map<ObjectGuid, PlayerbotAIBase*>::iterator itr = _playerbotsMgrMap.find(player->GetGUID());
-        if (itr != _playerbotsMgrMap.end())
-        {
-            _playerbotsMgrMap.erase(itr);
-        }
         PlayerbotMgr* playerbotMgr = new PlayerbotMgr(player);
-        ASSERT(_playerbotsMgrMap.emplace(player->GetGUID(), playerbotMgr).second);
+        _playerbotsMgrMap.Set(player->GetGUID(), playerbotMgr);
 
         playerbotMgr->OnPlayerLogin(player);
     }
     else
     {
-        std::unordered_map<ObjectGuid, PlayerbotAIBase*>::iterator itr = _playerbotsAIMap.find(player->GetGUID());
-        if (itr != _playerbotsAIMap.end())
-        {
-            _playerbotsAIMap.erase(itr);
-        }
         PlayerbotAI* botAI = new PlayerbotAI(player);
-        ASSERT(_playerbotsAIMap.emplace(player->GetGUID(), botAI).second);
+        _playerbotsAIMap.Set(player->GetGUID(), botAI);
     }
 }
 
-void PlayerbotsMgr::RemovePlayerBotData(ObjectGuid const& guid, bool is_AI)
+void PlayerbotsMgr::RemovePlayerBotData(ObjectGuid const& guid, bool is_AI, PlayerbotAIBase* expected)
 {
-    if (is_AI)
-    {
-        std::unordered_map<ObjectGuid, PlayerbotAIBase*>::iterator itr = _playerbotsAIMap.find(guid);
-        if (itr != _playerbotsAIMap.end())
-        {
-            _playerbotsAIMap.erase(itr);
-        }
-    }
+    PlayerbotRegistry& registry = is_AI ? _playerbotsAIMap : _playerbotsMgrMap;
+    if (expected)
+        registry.Remove(guid, expected);
     else
-    {
-        std::unordered_map<ObjectGuid, PlayerbotAIBase*>::iterator itr = _playerbotsMgrMap.find(guid);
-        if (itr != _playerbotsMgrMap.end())
-        {
-            _playerbotsMgrMap.erase(itr);
-        }
-    }
+        registry.Remove(guid);
 }
 
 PlayerbotAI* PlayerbotsMgr::GetPlayerbotAI(Player* player)
@@ -1765,12 +1754,9 @@ PlayerbotAI* PlayerbotsMgr::GetPlayerbotAI(Player* player)
     // {
     //     return nullptr;
     // }
-    auto itr = _playerbotsAIMap.find(player->GetGUID());
-    if (itr != _playerbotsAIMap.end())
-    {
-        if (itr->second->IsBotAI())
-            return reinterpret_cast<PlayerbotAI*>(itr->second);
-    }
+    PlayerbotAIBase* botAIBase = _playerbotsAIMap.Get(player->GetGUID());
+    if (botAIBase && botAIBase->IsBotAI())
+        return reinterpret_cast<PlayerbotAI*>(botAIBase);
 
     return nullptr;
 }
@@ -1781,16 +1767,19 @@ PlayerbotMgr* PlayerbotsMgr::GetPlayerbotMgr(Player* player)
     {
         return nullptr;
     }
-    auto itr = _playerbotsMgrMap.find(player->GetGUID());
-    if (itr != _playerbotsMgrMap.end())
-    {
-        if (!itr->second->IsBotAI())
-            return reinterpret_cast<PlayerbotMgr*>(itr->second);
-    }
+    PlayerbotAIBase* playerbotMgr = _playerbotsMgrMap.Get(player->GetGUID());
+    if (playerbotMgr && !playerbotMgr->IsBotAI())
+        return reinterpret_cast<PlayerbotMgr*>(playerbotMgr);
 
     return nullptr;
 }
 
+void PlayerbotsMgr::Update()
+{
+    _playerbotsAIMap.AdvanceEpoch();
+    _playerbotsMgrMap.AdvanceEpoch();
+}
+
 void PlayerbotMgr::HandleSetSecurityKeyCommand(Player* player, const std::string& key)
 {
     uint32 accountId = player->GetSession()->GetAccountId();
@@ -10,6 +10,7 @@
 #include "ObjectGuid.h"
 #include "Player.h"
 #include "PlayerbotAIBase.h"
+#include "PlayerbotRegistry.h"
 #include "QueryHolder.h"
 #include "QueryResult.h"
 
@@ -111,14 +112,21 @@ public:
     }
 
     void AddPlayerbotData(Player* player, bool isBotAI);
-    void RemovePlayerBotData(ObjectGuid const& guid, bool is_AI);
+    // expected limits the removal to that instance, nullptr removes whatever is registered
+    void RemovePlayerBotData(ObjectGuid const& guid, bool is_AI, PlayerbotAIBase* expected = nullptr);
 
     PlayerbotAI* GetPlayerbotAI(Player* player);
     PlayerbotMgr* GetPlayerbotMgr(Player* player);
 
+    // world thread, between map updates
+    void Update();
+
+    uint32 GetPlayerbotAICount() const { return _playerbotsAIMap.GetCount(); }
+    uint32 GetPlayerbotMgrCount() const { return _playerbotsMgrMap.GetCount(); }
+
 private:
-    std::unordered_map<ObjectGuid, PlayerbotAIBase*> _playerbotsAIMap;
-    std::unordered_map<ObjectGuid, PlayerbotAIBase*> _playerbotsMgrMap;
+    PlayerbotRegistry _playerbotsAIMap;
+    PlayerbotRegistry _playerbotsMgrMap;
 };
 
 #define sPlayerbotsMgr PlayerbotsMgr::instance()
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "PlayerbotPacketEvents.h"
+
+#include "SharedDefines.h"
+
+ObjectGuid PlayerbotPacketReader::ReadPackedGuid()
+{
+    uint8 mask = Read<uint8>();
+    uint64 value = 0;
+    for (uint8 i = 0; i < 8; ++i)
+    {
+        if (mask & (1 << i))
+            value |= uint64(Read<uint8>()) << (i * 8);
+    }
+
+    return ObjectGuid(value);
+}
+
+std::string_view PlayerbotPacketReader::ReadString()
+{
+    if (pos >= size)
+    {
+        failed = true;
+        return std::string_view();
+    }
+
+    char const* start = reinterpret_cast<char const*>(data + pos);
+    void const* end = std::memchr(start, 0, size - pos);
+    if (!end)
+    {
+        // unterminated strings take the rest of the packet, as ByteBuffer does
+        std::string_view value(start, size - pos);
+        pos = size;
+        return value;
+    }
+
+    std::string_view value(start, static_cast<char const*>(end) - start);
+    pos += value.size() + 1;
+    return value;
+}
+
+bool BotSpellFailureEvent::Read(WorldPacket const& packet)
+{
+    PlayerbotPacketReader reader(packet);
+    caster = reader.ReadPackedGuid();
+    castCount = reader.Read<uint8>();
+    spellId = reader.Read<uint32>();
+    result = reader.Read<uint8>();
+    return !reader.IsFailed();
+}
+
+bool BotSpellDelayedEvent::Read(WorldPacket const& packet)
+{
+    PlayerbotPacketReader reader(packet);
+    caster = reader.ReadPackedGuid();
+    delayTime = reader.Read<uint32>();
+    return !reader.IsFailed();
+}
+
+bool BotEmoteEvent::Read(WorldPacket const& packet)
+{
+    PlayerbotPacketReader reader(packet);
+    emoteId = reader.Read<uint32>();
+    source = reader.ReadGuid();
+    return !reader.IsFailed();
+}
+
+bool BotChatEvent::Read(WorldPacket const& packet)
+{
+    PlayerbotPacketReader reader(packet);
+    msgType = reader.Read<uint8>();
+    lang = reader.Read<uint32>();
+    sender = reader.ReadGuid();
+    reader.Read<uint32>();
+
+    if (packet.GetOpcode() == SMSG_GM_MESSAGECHAT)
+    {
+        reader.Read<uint32>();
+        senderName = reader.ReadString();
+    }
+
+    switch (msgType)
+    {
+        case CHAT_MSG_CHANNEL:
+            channelName = reader.ReadString();
+            [[fallthrough]];
+        case CHAT_MSG_SAY:
+        case CHAT_MSG_PARTY:
+        case CHAT_MSG_YELL:
+        case CHAT_MSG_WHISPER:
+        case CHAT_MSG_GUILD:
+            target = reader.ReadGuid();
+            reader.Read<uint32>();
+            message = reader.ReadString();
+            chatTag = reader.Read<uint8>();
+            break;
+        default:
+            return false;
+    }
+
+    return !reader.IsFailed();
+}
+
+bool BotKnockBackEvent::Read(WorldPacket const& packet)
+{
+    PlayerbotPacketReader reader(packet);
+    guid = reader.ReadPackedGuid();
+    counter = reader.Read<uint32>();
+    vcos = reader.Read<float>();
+    vsin = reader.Read<float>();
+    horizontalSpeed = reader.Read<float>();
+    verticalSpeed = reader.Read<float>();
+    return !reader.IsFailed();
+}
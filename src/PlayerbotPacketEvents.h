@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_PLAYERBOTPACKETEVENTS_H
+#define _PLAYERBOT_PLAYERBOTPACKETEVENTS_H
+
+#include <cstring>
+#include <string_view>
+
+#include "Common.h"
+#include "ObjectGuid.h"
+#include "WorldPacket.h"
+
+// Reads fields straight out of a packet the core built for a bot, without copying it. A read past the end marks the
+// reader as failed and yields empty values.
+class PlayerbotPacketReader
+{
+public:
+    PlayerbotPacketReader(WorldPacket const& packet) : data(packet.contents()), size(packet.size()) {}
+
+    template <class T>
+    T Read()
+    {
+        T value = T();
+        if (pos + sizeof(T) > size)
+        {
+            failed = true;
+            pos = size;
+            return value;
+        }
+
+        std::memcpy(&value, data + pos, sizeof(T));
+        EndianConvert(value);
+        pos += sizeof(T);
+        return value;
+    }
+
+    ObjectGuid ReadGuid() { return ObjectGuid(Read<uint64>()); }
+    ObjectGuid ReadPackedGuid();
+    // the view points into the packet and is only valid while the packet is
+    std::string_view ReadString();
+
+    bool IsFailed() const { return failed; }
+
+private:
+    uint8 const* data;
+    size_t size;
+    size_t pos = 0;
+    bool failed = false;
+};
+
+struct BotSpellFailureEvent
+{
+    ObjectGuid caster;
+    uint8 castCount = 0;
+    uint32 spellId = 0;
+    uint8 result = 0;
+
+    bool Read(WorldPacket const& packet);
+};
+
+struct BotSpellDelayedEvent
+{
+    ObjectGuid caster;
+    uint32 delayTime = 0;
+
+    bool Read(WorldPacket const& packet);
+};
+
+struct BotEmoteEvent
+{
+    uint32 emoteId = 0;
+    ObjectGuid source;
+
+    bool Read(WorldPacket const& packet);
+};
+
+struct BotChatEvent
+{
+    uint8 msgType = 0;
+    uint32 lang = 0;
+    ObjectGuid sender;
+    ObjectGuid target;
+    std::string_view senderName;
+    std::string_view channelName;
+    std::string_view message;
+    uint8 chatTag = 0;
+
+    // false for malformed packets and for chat types bots never answer
+    bool Read(WorldPacket const& packet);
+};
+
+struct BotKnockBackEvent
+{
+    ObjectGuid guid;
+    uint32 counter = 0;
+    float vcos = 0.0f;
+    float vsin = 0.0f;
+    float horizontalSpeed = 0.0f;
+    float verticalSpeed = 0.0f;
+
+    bool Read(WorldPacket const& packet);
+};
+
+#endif
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "PlayerbotQuestIndex.h"
+
+#include <algorithm>
+
+#include "LootMgr.h"
+#include "ObjectMgr.h"
+#include "Player.h"
+#include "Timer.h"
+
+static_assert(QUEST_OBJECTIVES_COUNT + QUEST_ITEM_OBJECTIVES_COUNT <= 32, "quest objectives do not fit the mask");
+
+// safety net for changes without an event, the events keep the index current in between
+static constexpr uint32 QUEST_INDEX_RESYNC = 10 * IN_MILLISECONDS;
+
+bool PlayerbotQuestIndex::IsOutdated(Player* bot) const
+{
+    if (!valid || botLevel != bot->GetLevel() || GetMSTimeDiffToNow(builtAt) > QUEST_INDEX_RESYNC)
+        return true;
+
+    // accepted, abandoned and rewarded quests change the log without a packet sent to the bot
+    for (uint8 slot = 0; slot < MAX_QUEST_LOG_SIZE; ++slot)
+    {
+        if (questSlots[slot] != bot->GetQuestSlotQuestId(slot))
+            return true;
+    }
+
+    return false;
+}
+
+void PlayerbotQuestIndex::Update(Player* bot)
+{
+    if (IsOutdated(bot))
+        Rebuild(bot);
+}
+
+void PlayerbotQuestIndex::Rebuild(Player* bot)
+{
+    npcOrGoDemand.clear();
+    itemDemand.clear();
+    incompleteQuests.clear();
+    completeQuests.clear();
+    questLoot.clear();
+    minIncompleteLevel = UINT32_MAX;
+
+    QuestStatusMap const& questMap = bot->getQuestStatusMap();
+    for (uint8 slot = 0; slot < MAX_QUEST_LOG_SIZE; ++slot)
+    {
+        uint32 questId = bot->GetQuestSlotQuestId(slot);
+        questSlots[slot] = questId;
+        if (!questId)
+            continue;
+
+        Quest const* quest = sObjectMgr->GetQuestTemplate(questId);
+        auto status = questMap.find(questId);
+        if (!quest || status == questMap.end())
+            continue;
+
+        QuestStatusData const& questStatus = status->second;
+
+        // items stay wanted until the quest is rewarded, the bot must not sell or destroy them
+        for (uint8 i = 0; i < QUEST_ITEM_OBJECTIVES_COUNT; ++i)
+        {
+            if (uint32 itemId = quest->RequiredItemId[i])
+            {
+                uint32& required = itemDemand[itemId];
+                required = std::max(required, quest->RequiredItemCount[i]);
+            }
+        }
+
+        if (questStatus.Status == QUEST_STATUS_COMPLETE)
+        {
+            if (!bot->GetQuestRewardStatus(questId))
+                completeQuests.push_back(questId);
+
+            continue;
+        }
+
+        if (questStatus.Status != QUEST_STATUS_INCOMPLETE)
+            continue;
+
+        // quests without a level scale with the player
+        uint32 level = quest->GetQuestLevel() > 0 ? uint32(quest->GetQuestLevel()) : bot->GetLevel();
+        QuestDemand& demand = incompleteQuests[questId];
+        demand.level = level;
+        minIncompleteLevel = std::min(minIncompleteLevel, level);
+
+        for (uint8 i = 0; i < QUEST_OBJECTIVES_COUNT; ++i)
+        {
+            int32 entry = quest->RequiredNpcOrGo[i];
+            if (!entry || questStatus.CreatureOrGOCount[i] >= quest->RequiredNpcOrGoCount[i])
+                continue;
+
+            demand.outstanding |= 1 << i;
+
+            auto [demandLevel, inserted] = npcOrGoDemand.emplace(entry, level);
+            if (!inserted)
+                demandLevel->second = std::min(demandLevel->second, level);
+        }
+
+        for (uint8 i = 0; i < QUEST_ITEM_OBJECTIVES_COUNT; ++i)
+        {
+            if (quest->RequiredItemId[i] && questStatus.ItemCount[i] < quest->RequiredItemCount[i])
+                demand.outstanding |= 1 << (QUEST_OBJECTIVES_COUNT + i);
+        }
+    }
+
+    botLevel = bot->GetLevel();
+    builtAt = getMSTime();
+    valid = true;
+}
+
+void PlayerbotQuestIndex::OnItemStored(uint32 itemId)
+{
+    if (valid && itemDemand.find(itemId) != itemDemand.end())
+        valid = false;
+}
+
+bool PlayerbotQuestIndex::NeedsNpcOrGo(int32 entry, uint32 maxQuestLevel) const
+{
+    auto demand = npcOrGoDemand.find(entry);
+    return demand != npcOrGoDemand.end() && demand->second <= maxQuestLevel;
+}
+
+uint32 PlayerbotQuestIndex::GetRequiredItemCount(uint32 itemId) const
+{
+    auto demand = itemDemand.find(itemId);
+    return demand == itemDemand.end() ? 0 : demand->second;
+}
+
+uint32 PlayerbotQuestIndex::GetOutstandingObjectives(uint32 questId) const
+{
+    auto demand = incompleteQuests.find(questId);
+    return demand == incompleteQuests.end() ? 0 : demand->second.outstanding;
+}
+
+bool PlayerbotQuestIndex::HasOutstandingObjectives(uint32 maxQuestLevel) const
+{
+    for (auto const& [questId, demand] : incompleteQuests)
+    {
+        if (demand.outstanding && demand.level <= maxQuestLevel)
+            return true;
+    }
+
+    return false;
+}
+
+bool PlayerbotQuestIndex::HasQuestLoot(uint32 lootId, Player* bot)
+{
+    if (incompleteQuests.empty())
+        return false;
+
+    auto loot = questLoot.find(lootId);
+    if (loot != questLoot.end())
+        return loot->second;
+
+    bool hasQuestLoot = LootTemplates_Creature.HaveQuestLootForPlayer(lootId, bot);
+    questLoot.emplace(lootId, hasQuestLoot);
+    return hasQuestLoot;
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_PLAYERBOTQUESTINDEX_H
+#define _PLAYERBOT_PLAYERBOTQUESTINDEX_H
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+#include "Define.h"
+#include "QuestDef.h"
+
+class Player;
+
+/**
+ * @brief Outstanding quest objectives of one bot, indexed by what they need
+ *
+ * Grind, travel and loot decisions ask whether a creature, gameobject or item is wanted by the quest log. The index
+ * answers with a hash lookup instead of walking every quest and objective per candidate. It is rebuilt lazily when a
+ * quest update packet or a new quest item marked it dirty, when the quest log or the bot level changed, and after a
+ * while to pick up changes no event reports (used or destroyed quest items).
+ */
+class PlayerbotQuestIndex
+{
+public:
+    // rebuilds the index if it is out of date, call before the lookups
+    void Update(Player* bot);
+
+    void Invalidate() { valid = false; }
+    void OnItemStored(uint32 itemId);
+
+    // an incomplete quest up to maxQuestLevel still needs kills or uses of the creature (positive) or gameobject
+    // (negative) entry
+    bool NeedsNpcOrGo(int32 entry, uint32 maxQuestLevel) const;
+    // highest count of the item required by a quest in the log, 0 if no quest needs it
+    uint32 GetRequiredItemCount(uint32 itemId) const;
+    // outstanding objectives of an incomplete quest, bit i for npc or gameobject objective i and
+    // bit QUEST_OBJECTIVES_COUNT + i for item objective i
+    uint32 GetOutstandingObjectives(uint32 questId) const;
+    bool HasIncompleteQuest(uint32 maxQuestLevel) const { return minIncompleteLevel <= maxQuestLevel; }
+    bool HasOutstandingObjectives(uint32 maxQuestLevel) const;
+    // completed quests waiting for their reward
+    std::vector<uint32> const& GetCompleteQuests() const { return completeQuests; }
+    // the loot template drops an item one of the bot's quests needs, remembered until the next rebuild
+    bool HasQuestLoot(uint32 lootId, Player* bot);
+
+private:
+    struct QuestDemand
+    {
+        uint32 level = 0;
+        uint32 outstanding = 0;
+    };
+
+    void Rebuild(Player* bot);
+    bool IsOutdated(Player* bot) const;
+
+    // creature or gameobject entry, lowest level of the quests needing it
+    std::unordered_map<int32, uint32> npcOrGoDemand;
+    std::unordered_map<uint32, uint32> itemDemand;
+    std::unordered_map<uint32, QuestDemand> incompleteQuests;
+    std::vector<uint32> completeQuests;
+    std::unordered_map<uint32, bool> questLoot;
+    uint32 minIncompleteLevel = UINT32_MAX;
+
+    std::array<uint32, MAX_QUEST_LOG_SIZE> questSlots = {};
+    uint8 botLevel = 0;
+    uint32 builtAt = 0;
+    bool valid = false;
+};
+
+#endif
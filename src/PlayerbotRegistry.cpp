@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "PlayerbotRegistry.h"
+
+#include <algorithm>
+
+PlayerbotRegistry::Directory::Directory(uint32 size) : size(size), segments(new std::atomic<Segment*>[size])
+{
+    for (uint32 i = 0; i < size; ++i)
+        segments[i].store(nullptr, std::memory_order_relaxed);
+}
+
+PlayerbotRegistry::Directory::~Directory() { delete[] segments; }
+
+PlayerbotRegistry::PlayerbotRegistry()
+    : m_directory(new Directory(REGISTRY_INITIAL_SEGMENTS)), m_epoch(0), m_segmentCount(0), m_count(0)
+{
+}
+
+PlayerbotRegistry::~PlayerbotRegistry()
+{
+    for (RetiredDirectory& retired : m_retired)
+        delete retired.directory;
+
+    delete m_directory.load(std::memory_order_relaxed);
+
+    for (Segment* segment : m_segments)
+        delete segment;
+}
+
+std::atomic<PlayerbotAIBase*>* PlayerbotRegistry::GetSlot(ObjectGuid const& guid, bool create)
+{
+    ObjectGuid::LowType counter = guid.GetCounter();
+    uint32 segmentIndex = counter >> REGISTRY_SEGMENT_BITS;
+    Directory* directory = m_directory.load(std::memory_order_relaxed);
+
+    if (segmentIndex >= directory->size)
+    {
+        if (!create)
+            return nullptr;
+
+        // readers may still hold the old directory, it is retired instead of freed
+        Directory* grown = new Directory(std::max(segmentIndex + 1, directory->size * 2));
+        for (uint32 i = 0; i < directory->size; ++i)
+            grown->segments[i].store(directory->segments[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+        m_directory.store(grown, std::memory_order_release);
+        m_retired.push_back({directory, m_epoch});
+        directory = grown;
+    }
+
+    Segment* segment = directory->segments[segmentIndex].load(std::memory_order_relaxed);
+    if (!segment)
+    {
+        if (!create)
+            return nullptr;
+
+        segment = new Segment();
+        m_segments.push_back(segment);
+        ++m_segmentCount;
+        directory->segments[segmentIndex].store(segment, std::memory_order_release);
+    }
+
+    return &segment->slots[counter & (REGISTRY_SEGMENT_SIZE - 1)];
+}
+
+PlayerbotAIBase* PlayerbotRegistry::Set(ObjectGuid const& guid, PlayerbotAIBase* value)
+{
+    std::lock_guard<std::mutex> guard(m_writeLock);
+
+    std::atomic<PlayerbotAIBase*>* slot = GetSlot(guid, true);
+    PlayerbotAIBase* previous = slot->exchange(value, std::memory_order_acq_rel);
+    if (!previous && value)
+        m_count.fetch_add(1, std::memory_order_relaxed);
+    else if (previous && !value)
+        m_count.fetch_sub(1, std::memory_order_relaxed);
+
+    return previous;
+}
+
+bool PlayerbotRegistry::Remove(ObjectGuid const& guid, PlayerbotAIBase* expected)
+{
+    std::lock_guard<std::mutex> guard(m_writeLock);
+
+    std::atomic<PlayerbotAIBase*>* slot = GetSlot(guid, false);
+    if (!slot || !expected)
+        return false;
+
+    if (!slot->compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel))
+        return false;
+
+    m_count.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool PlayerbotRegistry::Remove(ObjectGuid const& guid)
+{
+    std::lock_guard<std::mutex> guard(m_writeLock);
+
+    std::atomic<PlayerbotAIBase*>* slot = GetSlot(guid, false);
+    if (!slot || !slot->exchange(nullptr, std::memory_order_acq_rel))
+        return false;
+
+    m_count.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+void PlayerbotRegistry::AdvanceEpoch()
+{
+    std::lock_guard<std::mutex> guard(m_writeLock);
+
+    ++m_epoch;
+    if (m_retired.empty())
+        return;
+
+    // a directory retired during epoch N may still be read by map updates of epoch N, from N + 2 on nobody can
+    // reach it anymore
+    auto itr = std::remove_if(m_retired.begin(), m_retired.end(),
+                              [this](RetiredDirectory const& retired)
+                              {
+                                  if (retired.epoch + 2 > m_epoch)
+                                      return false;
+
+                                  delete retired.directory;
+                                  return true;
+                              });
+    m_retired.erase(itr, m_retired.end());
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_PLAYERBOTREGISTRY_H
+#define _PLAYERBOT_PLAYERBOTREGISTRY_H
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "Common.h"
+#include "ObjectGuid.h"
+
+class PlayerbotAIBase;
+
+#define REGISTRY_SEGMENT_BITS 10
+#define REGISTRY_SEGMENT_SIZE (1 << REGISTRY_SEGMENT_BITS)
+#define REGISTRY_INITIAL_SEGMENTS 64
+
+// Dense map from player guid counter to PlayerbotAIBase*.
+// Lookups are a few acquire loads and never lock: directory -> segment -> slot. Writers (logins and logouts) are
+// serialized by a mutex. Segments are never freed while the server runs; when the directory grows the old one is
+// retired and only freed once every map update that could still be reading it has finished (see AdvanceEpoch).
+class PlayerbotRegistry
+{
+public:
+    PlayerbotRegistry();
+    ~PlayerbotRegistry();
+
+    PlayerbotAIBase* Get(ObjectGuid const& guid) const
+    {
+        ObjectGuid::LowType counter = guid.GetCounter();
+        Directory const* directory = m_directory.load(std::memory_order_acquire);
+        uint32 segmentIndex = counter >> REGISTRY_SEGMENT_BITS;
+        if (segmentIndex >= directory->size)
+            return nullptr;
+
+        Segment const* segment = directory->segments[segmentIndex].load(std::memory_order_acquire);
+        if (!segment)
+            return nullptr;
+
+        return segment->slots[counter & (REGISTRY_SEGMENT_SIZE - 1)].load(std::memory_order_acquire);
+    }
+
+    // Returns the entry that was replaced, if any
+    PlayerbotAIBase* Set(ObjectGuid const& guid, PlayerbotAIBase* value);
+    // Only clears the slot while it still holds the given value, so a late destructor can not unlink its successor
+    bool Remove(ObjectGuid const& guid, PlayerbotAIBase* expected);
+    bool Remove(ObjectGuid const& guid);
+
+    // Called from the world thread between map updates, frees directories retired two epochs ago
+    void AdvanceEpoch();
+
+    uint32 GetCount() const { return m_count.load(std::memory_order_relaxed); }
+    uint32 GetSegmentCount() const { return m_segmentCount; }
+
+private:
+    struct Segment
+    {
+        std::atomic<PlayerbotAIBase*> slots[REGISTRY_SEGMENT_SIZE];
+
+        Segment()
+        {
+            for (std::atomic<PlayerbotAIBase*>& slot : slots)
+                slot.store(nullptr, std::memory_order_relaxed);
+        }
+    };
+
+    struct Directory
+    {
+        uint32 size;
+        std::atomic<Segment*>* segments;
+
+        Directory(uint32 size);
+        ~Directory();
+    };
+
+    struct RetiredDirectory
+    {
+        Directory* directory;
+        uint64 epoch;
+    };
+
+    std::atomic<PlayerbotAIBase*>* GetSlot(ObjectGuid const& guid, bool create);
+
+    std::atomic<Directory*> m_directory;
+    std::mutex m_writeLock;
+    std::vector<Segment*> m_segments;
+    std::vector<RetiredDirectory> m_retired;
+    uint64 m_epoch;
+    uint32 m_segmentCount;
+    std::atomic<uint32> m_count;
+};
+
+#endif
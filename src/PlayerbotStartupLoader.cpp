@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "PlayerbotStartupLoader.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "Log.h"
+#include "Timer.h"
+
+void PlayerbotStartupLoader::AddStage(std::string const name, StageFunc func,
+                                      std::vector<std::string> const dependencies)
+{
+    Stage stage;
+    stage.name = name;
+    stage.func = std::move(func);
+
+    uint32 const index = stages.size();
+    for (std::string const& dependency : dependencies)
+    {
+        bool found = false;
+        for (Stage& other : stages)
+        {
+            if (other.name != dependency)
+                continue;
+
+            other.dependents.push_back(index);
+            ++stage.pendingDependencies;
+            found = true;
+            break;
+        }
+
+        if (!found)
+            LOG_ERROR("playerbots", "Startup stage {} depends on unknown stage {}, ignored", name, dependency);
+    }
+
+    stages.push_back(std::move(stage));
+}
+
+void PlayerbotStartupLoader::Run(uint32 threads)
+{
+    if (stages.empty())
+        return;
+
+    uint32 const startTime = getMSTime();
+
+    std::mutex lock;
+    std::condition_variable wakeUp;
+    std::deque<uint32> ready;
+    uint32 remaining = stages.size();
+
+    for (uint32 i = 0; i < stages.size(); ++i)
+    {
+        if (!stages[i].pendingDependencies)
+            ready.push_back(i);
+    }
+
+    auto worker = [&]()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        while (remaining)
+        {
+            if (ready.empty())
+            {
+                wakeUp.wait(guard);
+                continue;
+            }
+
+            uint32 const index = ready.front();
+            ready.pop_front();
+            Stage& stage = stages[index];
+
+            guard.unlock();
+            uint32 const stageStart = getMSTime();
+            stage.func();
+            stage.duration = GetMSTimeDiffToNow(stageStart);
+            LOG_INFO("server.loading", ">> Playerbots startup stage {} done in {} ms", stage.name, stage.duration);
+            guard.lock();
+
+            for (uint32 dependent : stage.dependents)
+            {
+                if (!--stages[dependent].pendingDependencies)
+                    ready.push_back(dependent);
+            }
+
+            --remaining;
+            wakeUp.notify_all();
+        }
+    };
+
+    // the calling thread is one of the workers, a single thread runs the stages serially in dependency order
+    threads = std::max<uint32>(1, std::min<uint32>(threads, stages.size()));
+    std::vector<std::thread> pool;
+    for (uint32 i = 1; i < threads; ++i)
+        pool.emplace_back(worker);
+
+    worker();
+
+    for (std::thread& thread : pool)
+        thread.join();
+
+    uint32 serialTime = 0;
+    for (Stage const& stage : stages)
+        serialTime += stage.duration;
+
+    LOG_INFO("server.loading", ">> Playerbots startup stages done in {} ms on {} threads ({} ms of work)",
+             GetMSTimeDiffToNow(startTime), threads, serialTime);
+
+    stages.clear();
+}
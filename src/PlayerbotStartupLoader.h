@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_PLAYERBOTSTARTUPLOADER_H
+#define _PLAYERBOT_PLAYERBOTSTARTUPLOADER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Common.h"
+
+/**
+ * @brief Runs the playerbot cache builders of server startup as a small dependency graph
+ *
+ * Stages without pending dependencies are handed to a pool of worker threads. Each stage is timed and Run() only
+ * returns once every stage has finished, so callers see the same state as with the former serial initialization.
+ * Stages must only touch their own caches and read-only core stores (templates, DBC, prepared statements).
+ */
+class PlayerbotStartupLoader
+{
+public:
+    typedef std::function<void()> StageFunc;
+
+    // dependencies are names of stages added before
+    void AddStage(std::string const name, StageFunc func, std::vector<std::string> const dependencies = {});
+    void Run(uint32 threads);
+
+private:
+    struct Stage
+    {
+        std::string name;
+        StageFunc func;
+        std::vector<uint32> dependents;
+        uint32 pendingDependencies = 0;
+        uint32 duration = 0;
+    };
+
+    std::vector<Stage> stages;
+};
+
+#endif
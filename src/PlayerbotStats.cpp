@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "PlayerbotStats.h"
+
+#include "Playerbots.h"
+
+static_assert(MAX_STATS_RPG_STATUS == RPG_STATUS_END, "rpg status counters out of sync with NewRpgStatus");
+static_assert(MAX_STATS_ENGINE_STATE == BOT_STATE_MAX, "engine counters out of sync with BotState");
+static_assert(MAX_STATS_ACTIVITY_TIER == MAX_ACTIVITY_TIER, "tier counters out of sync with BotActivityTier");
+
+void PlayerbotStats::Track(PlayerbotAI* botAI)
+{
+    PlayerbotStatsSample& current = botAI->statsSample;
+    if (current.tracked)
+        return;
+
+    current = Sample(botAI, PlayerbotStatsSample());
+    current.tracked = true;
+    Apply(current, 1);
+}
+
+void PlayerbotStats::Untrack(PlayerbotAI* botAI)
+{
+    PlayerbotStatsSample& current = botAI->statsSample;
+    PlayerbotCastCheckCounters& castCheck = botAI->castCheckCounters;
+    if (!current.tracked)
+    {
+        castCheck = PlayerbotCastCheckCounters();
+        return;
+    }
+
+    if (castCheck.checks)
+    {
+        castChecks.fetch_add(castCheck.checks, std::memory_order_relaxed);
+        castCheckMemoHits.fetch_add(castCheck.memoHits, std::memory_order_relaxed);
+        spellProbes.fetch_add(castCheck.spellProbes, std::memory_order_relaxed);
+        castCheck = PlayerbotCastCheckCounters();
+    }
+
+    Apply(current, -1);
+    current = PlayerbotStatsSample();
+}
+
+void PlayerbotStats::Publish(PlayerbotAI* botAI)
+{
+    PlayerbotStatsSample& current = botAI->statsSample;
+    PlayerbotCastCheckCounters& castCheck = botAI->castCheckCounters;
+    if (!current.tracked)
+    {
+        castCheck = PlayerbotCastCheckCounters();
+        return;
+    }
+
+    if (castCheck.checks)
+    {
+        castChecks.fetch_add(castCheck.checks, std::memory_order_relaxed);
+        castCheckMemoHits.fetch_add(castCheck.memoHits, std::memory_order_relaxed);
+        spellProbes.fetch_add(castCheck.spellProbes, std::memory_order_relaxed);
+        castCheck = PlayerbotCastCheckCounters();
+    }
+
+    NewRpgStatistic& rpgStatistic = botAI->rpgStatistic;
+    quests[STATS_QUEST_ACCEPTED] += rpgStatistic.questAccepted;
+    quests[STATS_QUEST_COMPLETED] += rpgStatistic.questCompleted;
+    quests[STATS_QUEST_ABANDONED] += rpgStatistic.questAbandoned;
+    quests[STATS_QUEST_REWARDED] += rpgStatistic.questRewarded;
+    quests[STATS_QUEST_DROPPED] += rpgStatistic.questDropped;
+    rpgStatistic = NewRpgStatistic();
+
+    PlayerbotStatsSample sample = Sample(botAI, current);
+    if (sample.flags == current.flags && sample.level == current.level && sample.zoneId == current.zoneId &&
+        sample.engineState == current.engineState && sample.rpgStatus == current.rpgStatus &&
+        sample.role == current.role && sample.activityTier == current.activityTier)
+        return;
+
+    Apply(current, -1);
+    Apply(sample, 1);
+    current = sample;
+}
+
+PlayerbotStatsSample PlayerbotStats::Sample(PlayerbotAI* botAI, PlayerbotStatsSample const& previous) const
+{
+    Player* bot = botAI->GetBot();
+
+    PlayerbotStatsSample sample = previous;
+    sample.alliance = IsAlliance(bot->getRace());
+    sample.level = bot->GetLevel();
+    sample.race = bot->getRace();
+    sample.cls = bot->getClass();
+    sample.engineState = botAI->GetState();
+    sample.rpgStatus = sPlayerbotAIConfig->enableNewRpgStrategy ? uint8(botAI->rpgInfo.status) : 0;
+    sample.zoneId = bot->GetZoneId();
+    sample.activityTier = botAI->GetActivityTier();
+
+    // spec based role checks walk talents, only redo them when the level (and so the talents) changed
+    if (!previous.tracked || previous.level != sample.level)
+    {
+        if (PlayerbotAI::IsHeal(bot, true))
+            sample.role = STATS_ROLE_HEAL;
+        else if (PlayerbotAI::IsTank(bot, true))
+            sample.role = STATS_ROLE_TANK;
+        else
+            sample.role = STATS_ROLE_DPS;
+    }
+
+    uint32 flags = 0;
+    if (botAI->AllowActivity())
+        flags |= 1 << STATS_FLAG_ACTIVE;
+    if (bot->isDead())
+        flags |= 1 << STATS_FLAG_DEAD;
+    if (bot->IsInCombat())
+        flags |= 1 << STATS_FLAG_COMBAT;
+    if (bot->isMoving())
+        flags |= 1 << STATS_FLAG_MOVING;
+    if (bot->IsInFlight())
+        flags |= 1 << STATS_FLAG_IN_FLIGHT;
+    if (bot->IsMounted())
+        flags |= 1 << STATS_FLAG_MOUNTED;
+    if (bot->InBattleground() || bot->InArena())
+        flags |= 1 << STATS_FLAG_IN_BG;
+    if (bot->HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_RESTING))
+        flags |= 1 << STATS_FLAG_RESTING;
+    sample.flags = flags;
+
+    return sample;
+}
+
+void PlayerbotStats::Apply(PlayerbotStatsSample const& sample, int32 delta)
+{
+    online += delta;
+
+    if (sample.alliance)
+        alliancePerLevel[sample.level] += delta;
+    else
+        hordePerLevel[sample.level] += delta;
+
+    if (sample.race < MAX_RACES)
+    {
+        perRace[sample.race] += delta;
+        levelSumPerRace[sample.race] += delta * sample.level;
+    }
+
+    if (sample.cls < MAX_CLASSES)
+    {
+        perClass[sample.cls] += delta;
+        levelSumPerClass[sample.cls] += delta * sample.level;
+    }
+
+    perRole[sample.role] += delta;
+
+    for (uint8 flag = 0; flag < MAX_STATS_FLAG; ++flag)
+    {
+        if (sample.flags & (1 << flag))
+            perFlag[flag] += delta;
+    }
+
+    if (sample.engineState < MAX_STATS_ENGINE_STATE)
+        perEngineState[sample.engineState] += delta;
+
+    if (sample.rpgStatus < MAX_STATS_RPG_STATUS)
+        perRpgStatus[sample.rpgStatus] += delta;
+
+    if (sample.activityTier < MAX_STATS_ACTIVITY_TIER)
+        perActivityTier[sample.activityTier] += delta;
+
+    if (sample.zoneId < MAX_STATS_ZONE_ID)
+        perZone[sample.zoneId] += delta;
+}
+
+PlayerbotStatsSnapshot PlayerbotStats::GetSnapshot() const
+{
+    // counters are read one by one, a bot changing state meanwhile may be off by one in a single category
+    auto read = [](std::atomic<int32> const& counter) { return uint32(std::max(0, counter.load())); };
+
+    PlayerbotStatsSnapshot snapshot;
+    snapshot.online = read(online);
+
+    for (uint32 i = 0; i < MAX_STATS_LEVEL; ++i)
+    {
+        snapshot.alliancePerLevel[i] = read(alliancePerLevel[i]);
+        snapshot.hordePerLevel[i] = read(hordePerLevel[i]);
+    }
+
+    for (uint8 i = 0; i < MAX_RACES; ++i)
+    {
+        snapshot.perRace[i] = read(perRace[i]);
+        snapshot.levelSumPerRace[i] = read(levelSumPerRace[i]);
+    }
+
+    for (uint8 i = 0; i < MAX_CLASSES; ++i)
+    {
+        snapshot.perClass[i] = read(perClass[i]);
+        snapshot.levelSumPerClass[i] = read(levelSumPerClass[i]);
+    }
+
+    for (uint8 i = 0; i < MAX_STATS_ROLE; ++i)
+        snapshot.perRole[i] = read(perRole[i]);
+
+    for (uint8 i = 0; i < MAX_STATS_FLAG; ++i)
+        snapshot.perFlag[i] = read(perFlag[i]);
+
+    for (uint8 i = 0; i < MAX_STATS_ENGINE_STATE; ++i)
+        snapshot.perEngineState[i] = read(perEngineState[i]);
+
+    for (uint8 i = 0; i < MAX_STATS_RPG_STATUS; ++i)
+        snapshot.perRpgStatus[i] = read(perRpgStatus[i]);
+
+    for (uint8 i = 0; i < MAX_STATS_ACTIVITY_TIER; ++i)
+        snapshot.perActivityTier[i] = read(perActivityTier[i]);
+
+    for (uint8 i = 0; i < MAX_STATS_QUEST; ++i)
+        snapshot.quests[i] = quests[i].load();
+
+    snapshot.castChecks = castChecks.load(std::memory_order_relaxed);
+    snapshot.castCheckMemoHits = castCheckMemoHits.load(std::memory_order_relaxed);
+    snapshot.spellProbes = spellProbes.load(std::memory_order_relaxed);
+
+    return snapshot;
+}
+
+uint32 PlayerbotStats::GetZoneCount(uint32 zoneId) const
+{
+    if (zoneId >= MAX_STATS_ZONE_ID)
+        return 0;
+
+    return uint32(std::max(0, perZone[zoneId].load()));
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_PLAYERBOTSTATS_H
+#define _PLAYERBOT_PLAYERBOTSTATS_H
+
+#include <atomic>
+
+#include "Common.h"
+#include "SharedDefines.h"
+
+class PlayerbotAI;
+
+#define MAX_STATS_LEVEL 256
+#define MAX_STATS_ZONE_ID 8192
+#define MAX_STATS_RPG_STATUS 8
+#define MAX_STATS_ENGINE_STATE 3
+#define MAX_STATS_ACTIVITY_TIER 5
+
+enum PlayerbotStatsFlag
+{
+    STATS_FLAG_ACTIVE,
+    STATS_FLAG_DEAD,
+    STATS_FLAG_COMBAT,
+    STATS_FLAG_MOVING,
+    STATS_FLAG_IN_FLIGHT,
+    STATS_FLAG_MOUNTED,
+    STATS_FLAG_IN_BG,
+    STATS_FLAG_RESTING,
+    MAX_STATS_FLAG
+};
+
+enum PlayerbotStatsRole
+{
+    STATS_ROLE_TANK,
+    STATS_ROLE_HEAL,
+    STATS_ROLE_DPS,
+    MAX_STATS_ROLE
+};
+
+enum PlayerbotStatsQuest
+{
+    STATS_QUEST_ACCEPTED,
+    STATS_QUEST_COMPLETED,
+    STATS_QUEST_ABANDONED,
+    STATS_QUEST_REWARDED,
+    STATS_QUEST_DROPPED,
+    MAX_STATS_QUEST
+};
+
+// State of one bot as last published into the shared counters
+struct PlayerbotStatsSample
+{
+    bool tracked = false;
+    bool alliance = false;
+    uint8 level = 0;
+    uint8 race = 0;
+    uint8 cls = 0;
+    uint8 role = STATS_ROLE_DPS;
+    uint8 engineState = 0;
+    uint8 rpgStatus = 0;
+    uint8 activityTier = 0;
+    uint16 zoneId = 0;
+    uint32 flags = 0;
+};
+
+// CanCastSpell work done by one bot since its last publish
+struct PlayerbotCastCheckCounters
+{
+    uint32 checks = 0;
+    uint32 memoHits = 0;
+    uint32 spellProbes = 0;
+};
+
+// Plain copy of the counters, readable without touching any bot
+struct PlayerbotStatsSnapshot
+{
+    uint32 online = 0;
+    uint32 alliancePerLevel[MAX_STATS_LEVEL] = {};
+    uint32 hordePerLevel[MAX_STATS_LEVEL] = {};
+    uint32 perRace[MAX_RACES] = {};
+    uint32 levelSumPerRace[MAX_RACES] = {};
+    uint32 perClass[MAX_CLASSES] = {};
+    uint32 levelSumPerClass[MAX_CLASSES] = {};
+    uint32 perRole[MAX_STATS_ROLE] = {};
+    uint32 perFlag[MAX_STATS_FLAG] = {};
+    uint32 perEngineState[MAX_STATS_ENGINE_STATE] = {};
+    uint32 perRpgStatus[MAX_STATS_RPG_STATUS] = {};
+    uint32 perActivityTier[MAX_STATS_ACTIVITY_TIER] = {};
+    uint32 quests[MAX_STATS_QUEST] = {};
+    uint64 castChecks = 0;
+    uint64 castCheckMemoHits = 0;
+    uint64 spellProbes = 0;
+};
+
+/**
+ * @brief Incrementally maintained random bot population counters
+ *
+ * Every tracked bot publishes its state from its own update (map thread) and only the difference to its
+ * previously published sample is applied to the shared atomic counters. Readers take a snapshot in
+ * O(categories) instead of walking all bots on the world thread.
+ */
+class PlayerbotStats
+{
+public:
+    static PlayerbotStats* instance()
+    {
+        static PlayerbotStats instance;
+        return &instance;
+    }
+
+    void Track(PlayerbotAI* botAI);
+    void Untrack(PlayerbotAI* botAI);
+    void Publish(PlayerbotAI* botAI);
+
+    PlayerbotStatsSnapshot GetSnapshot() const;
+    uint32 GetZoneCount(uint32 zoneId) const;
+
+private:
+    PlayerbotStats() = default;
+
+    PlayerbotStatsSample Sample(PlayerbotAI* botAI, PlayerbotStatsSample const& previous) const;
+    void Apply(PlayerbotStatsSample const& sample, int32 delta);
+
+    std::atomic<int32> online{0};
+    std::atomic<int32> alliancePerLevel[MAX_STATS_LEVEL] = {};
+    std::atomic<int32> hordePerLevel[MAX_STATS_LEVEL] = {};
+    std::atomic<int32> perRace[MAX_RACES] = {};
+    std::atomic<int32> levelSumPerRace[MAX_RACES] = {};
+    std::atomic<int32> perClass[MAX_CLASSES] = {};
+    std::atomic<int32> levelSumPerClass[MAX_CLASSES] = {};
+    std::atomic<int32> perRole[MAX_STATS_ROLE] = {};
+    std::atomic<int32> perFlag[MAX_STATS_FLAG] = {};
+    std::atomic<int32> perEngineState[MAX_STATS_ENGINE_STATE] = {};
+    std::atomic<int32> perRpgStatus[MAX_STATS_RPG_STATUS] = {};
+    std::atomic<int32> perActivityTier[MAX_STATS_ACTIVITY_TIER] = {};
+    std::atomic<int32> perZone[MAX_STATS_ZONE_ID] = {};
+    std::atomic<uint32> quests[MAX_STATS_QUEST] = {};
+    std::atomic<uint64> castChecks{0};
+    std::atomic<uint64> castCheckMemoHits{0};
+    std::atomic<uint64> spellProbes{0};
+};
+
+#define sPlayerbotStats PlayerbotStats::instance()
+
+#endif
@@ -5,6 +5,8 @@
 
 #include "PlayerbotTextMgr.h"
 
+#include <cctype>
+
 #include "Playerbots.h"
 #include "WorldSessionMgr.h"
 
@@ -20,10 +22,96 @@ void PlayerbotTextMgr::replaceAll(std::string& str, const std::string& from, con
     }
 }
 
+namespace
+{
+bool IsPlaceholderChar(char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; }
+}  // namespace
+
+BotTextTemplate::BotTextTemplate(std::string const& text) : source(text)
+{
+    uint32 literalStart = 0;
+    uint32 pos = 0;
+    uint32 const size = source.size();
+    while (pos < size)
+    {
+        char const c = source[pos];
+        if (c != '%' && c != '<')
+        {
+            ++pos;
+            continue;
+        }
+
+        uint32 tokenEnd = pos + 1;
+        while (tokenEnd < size && IsPlaceholderChar(source[tokenEnd]))
+            ++tokenEnd;
+
+        if (tokenEnd == pos + 1 || (c == '<' && (tokenEnd >= size || source[tokenEnd] != '>')))
+        {
+            ++pos;
+            continue;
+        }
+
+        if (c == '<')
+            ++tokenEnd;
+
+        if (pos > literalStart)
+            segments.push_back({literalStart, pos - literalStart, false});
+
+        segments.push_back({pos, tokenEnd - pos, true});
+        pos = tokenEnd;
+        literalStart = tokenEnd;
+    }
+
+    if (size > literalStart)
+        segments.push_back({literalStart, size - literalStart, false});
+}
+
+void BotTextTemplate::Render(std::string& out, std::map<std::string, std::string> const& placeholders) const
+{
+    out.clear();
+    out.reserve(source.size() + placeholders.size() * 16);
+
+    std::string key;
+    for (Segment const& segment : segments)
+    {
+        if (!segment.placeholder || placeholders.empty())
+        {
+            out.append(source, segment.offset, segment.length);
+            continue;
+        }
+
+        key.assign(source, segment.offset, segment.length);
+        auto itr = placeholders.find(key);
+
+        // "%name" tokens are greedy, so a shorter placeholder may still match a prefix of them (e.g. "%s" in "%ss")
+        if (itr == placeholders.end() && key[0] == '%')
+        {
+            while (key.size() > 2 && itr == placeholders.end())
+            {
+                key.pop_back();
+                itr = placeholders.find(key);
+            }
+        }
+
+        if (itr == placeholders.end())
+        {
+            out.append(source, segment.offset, segment.length);
+            continue;
+        }
+
+        out.append(itr->second);
+        out.append(source, segment.offset + key.size(), segment.length - key.size());
+    }
+}
+
 void PlayerbotTextMgr::LoadBotTexts()
 {
     LOG_INFO("playerbots", "Loading playerbots texts...");
 
+    botTexts.clear();
+    for (std::vector<uint32>& replies : replyTexts)
+        replies.clear();
+
     uint32 count = 0;
     if (PreparedQueryResult result =
             PlayerbotsDatabase.Query(PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_SEL_TEXT)))
@@ -46,6 +134,17 @@ void PlayerbotTextMgr::LoadBotTexts()
         } while (result->NextRow());
     }
 
+    auto replies = botTexts.find("reply");
+    if (replies != botTexts.end())
+    {
+        for (uint32 i = 0; i < replies->second.size(); ++i)
+        {
+            uint32 replyType = replies->second[i].m_replyType;
+            if (replyType < MAX_CHAT_REPLY_TYPE)
+                replyTexts[replyType].push_back(i);
+        }
+    }
+
     LOG_INFO("playerbots", "{} playerbots texts loaded", count);
 }
 
@@ -68,46 +167,76 @@ void PlayerbotTextMgr::LoadBotTextChance()
     }
 }
 
-// general texts
-
-std::string PlayerbotTextMgr::GetBotText(std::string name)
+BotTextEntry const* PlayerbotTextMgr::SelectBotText(std::string const& name)
 {
     if (botTexts.empty())
     {
         LOG_ERROR("playerbots", "Can't get bot text {}! No bots texts loaded!", name);
-        return "";
+        return nullptr;
     }
 
-    if (botTexts[name].empty())
+    auto itr = botTexts.find(name);
+    if (itr == botTexts.end() || itr->second.empty())
     {
         LOG_ERROR("playerbots", "Can't get bot text {}! No bots texts for this name!", name);
-        return "";
+        return nullptr;
     }
 
-    std::vector<BotTextEntry>& list = botTexts[name];
-    BotTextEntry textEntry = list[urand(0, list.size() - 1)];
-    return !textEntry.m_text[GetLocalePriority()].empty() ? textEntry.m_text[GetLocalePriority()] : textEntry.m_text[0];
+    std::vector<BotTextEntry> const& list = itr->second;
+    return &list[urand(0, list.size() - 1)];
 }
 
-std::string PlayerbotTextMgr::GetBotText(std::string name, std::map<std::string, std::string> placeholders)
+BotTextEntry const* PlayerbotTextMgr::SelectBotText(ChatReplyType replyType)
 {
-    std::string botText = GetBotText(name);
-    if (botText.empty())
+    if (botTexts.empty())
+    {
+        LOG_ERROR("playerbots", "Can't get bot text reply {}! No bots texts loaded!", replyType);
+        return nullptr;
+    }
+
+    auto replies = botTexts.find("reply");
+    if (replies == botTexts.end() || replies->second.empty())
+    {
+        LOG_ERROR("playerbots", "Can't get bot text reply {}! No bots texts replies!", replyType);
+        return nullptr;
+    }
+
+    if (replyType >= MAX_CHAT_REPLY_TYPE || replyTexts[replyType].empty())
+        return nullptr;
+
+    std::vector<uint32> const& indexes = replyTexts[replyType];
+    return &replies->second[indexes[urand(0, indexes.size() - 1)]];
+}
+
+// general texts
+
+std::string PlayerbotTextMgr::GetBotText(std::string const& name)
+{
+    BotTextEntry const* textEntry = SelectBotText(name);
+    if (!textEntry)
         return "";
 
-    for (std::map<std::string, std::string>::iterator i = placeholders.begin(); i != placeholders.end(); ++i)
-        replaceAll(botText, i->first, i->second);
+    return textEntry->GetTemplate(GetLocalePriority()).GetSource();
+}
+
+std::string PlayerbotTextMgr::GetBotText(std::string const& name, std::map<std::string, std::string> const& placeholders)
+{
+    BotTextEntry const* textEntry = SelectBotText(name);
+    if (!textEntry)
+        return "";
 
+    std::string botText;
+    textEntry->GetTemplate(GetLocalePriority()).Render(botText, placeholders);
     return botText;
 }
 
-std::string PlayerbotTextMgr::GetBotTextOrDefault(std::string name, std::string defaultText,
-    std::map<std::string, std::string> placeholders)
+std::string PlayerbotTextMgr::GetBotTextOrDefault(std::string const& name, std::string defaultText,
+    std::map<std::string, std::string> const& placeholders)
 {
     std::string botText = GetBotText(name, placeholders);
     if (botText.empty())
     {
-        for (std::map<std::string, std::string>::iterator i = placeholders.begin(); i != placeholders.end(); ++i)
+        for (std::map<std::string, std::string>::const_iterator i = placeholders.begin(); i != placeholders.end(); ++i)
         {
             replaceAll(defaultText, i->first, i->second);
         }
@@ -119,40 +248,18 @@ std::string PlayerbotTextMgr::GetBotTextOrDefault(std::string name, std::string
 
 // chat replies
 
-std::string PlayerbotTextMgr::GetBotText(ChatReplyType replyType, std::map<std::string, std::string> placeholders)
+std::string PlayerbotTextMgr::GetBotText(ChatReplyType replyType, std::map<std::string, std::string> const& placeholders)
 {
-    if (botTexts.empty())
-    {
-        LOG_ERROR("playerbots", "Can't get bot text reply {}! No bots texts loaded!", replyType);
-        return "";
-    }
-    if (botTexts["reply"].empty())
-    {
-        LOG_ERROR("playerbots", "Can't get bot text reply {}! No bots texts replies!", replyType);
-        return "";
-    }
-
-    std::vector<BotTextEntry>& list = botTexts["reply"];
-    std::vector<BotTextEntry> proper_list;
-    for (auto text : list)
-    {
-        if (text.m_replyType == replyType)
-            proper_list.push_back(text);
-    }
-
-    if (proper_list.empty())
+    BotTextEntry const* textEntry = SelectBotText(replyType);
+    if (!textEntry)
         return "";
 
-    BotTextEntry textEntry = proper_list[urand(0, proper_list.size() - 1)];
-    std::string botText =
-        !textEntry.m_text[GetLocalePriority()].empty() ? textEntry.m_text[GetLocalePriority()] : textEntry.m_text[0];
-    for (auto& placeholder : placeholders)
-        replaceAll(botText, placeholder.first, placeholder.second);
-
+    std::string botText;
+    textEntry->GetTemplate(GetLocalePriority()).Render(botText, placeholders);
     return botText;
 }
 
-std::string PlayerbotTextMgr::GetBotText(ChatReplyType replyType, std::string name)
+std::string PlayerbotTextMgr::GetBotText(ChatReplyType replyType, std::string const& name)
 {
     std::map<std::string, std::string> placeholders;
     placeholders["%s"] = name;
@@ -162,15 +269,16 @@ std::string PlayerbotTextMgr::GetBotText(ChatReplyType replyType, std::string na
 
 // probabilities
 
-bool PlayerbotTextMgr::rollTextChance(std::string name)
+bool PlayerbotTextMgr::rollTextChance(std::string const& name)
 {
-    if (!botTextChance[name])
+    auto itr = botTextChance.find(name);
+    if (itr == botTextChance.end() || !itr->second)
         return true;
 
-    return urand(0, 100) < botTextChance[name];
+    return urand(0, 100) < itr->second;
 }
 
-bool PlayerbotTextMgr::GetBotText(std::string name, std::string& text)
+bool PlayerbotTextMgr::GetBotText(std::string const& name, std::string& text)
 {
     if (!rollTextChance(name))
         return false;
@@ -179,7 +287,8 @@ bool PlayerbotTextMgr::GetBotText(std::string name, std::string& text)
     return !text.empty();
 }
 
-bool PlayerbotTextMgr::GetBotText(std::string name, std::string& text, std::map<std::string, std::string> placeholders)
+bool PlayerbotTextMgr::GetBotText(std::string const& name, std::string& text,
+                                  std::map<std::string, std::string> const& placeholders)
 {
     if (!rollTextChance(name))
         return false;
@@ -7,6 +7,8 @@
 #define _PLAYERBOT_PLAYERBOTTEXTMGR_H
 
 #include <map>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common.h"
@@ -14,16 +16,53 @@
 #define BOT_TEXT1(name) sPlayerbotTextMgr->GetBotText(name)
 #define BOT_TEXT2(name, replace) sPlayerbotTextMgr->GetBotText(name, replace)
 
+// Bot text pre-parsed at load time into literal runs and placeholder tokens ("%name" or "<name>"),
+// so rendering is a single pass without repeated search and replace.
+class BotTextTemplate
+{
+public:
+    BotTextTemplate() = default;
+    explicit BotTextTemplate(std::string const& text);
+
+    bool IsEmpty() const { return source.empty(); }
+    std::string const& GetSource() const { return source; }
+    void Render(std::string& out, std::map<std::string, std::string> const& placeholders) const;
+
+private:
+    struct Segment
+    {
+        uint32 offset;
+        uint32 length;
+        bool placeholder;
+    };
+
+    std::string source;
+    std::vector<Segment> segments;
+};
+
 struct BotTextEntry
 {
     BotTextEntry(std::string name, std::map<uint32, std::string> text, uint32 say_type, uint32 reply_type)
         : m_name(name), m_text(text), m_sayType(say_type), m_replyType(reply_type)
     {
+        for (auto const& localeText : m_text)
+        {
+            if (localeText.first < MAX_LOCALES && !localeText.second.empty())
+                m_compiled[localeText.first] = BotTextTemplate(localeText.second);
+        }
+    }
+
+    // falls back to the default locale when the text is not translated
+    BotTextTemplate const& GetTemplate(uint32 locale) const
+    {
+        return locale < MAX_LOCALES && !m_compiled[locale].IsEmpty() ? m_compiled[locale] : m_compiled[0];
     }
+
     std::string m_name;
     std::map<uint32, std::string> m_text;
     uint32 m_sayType;
     uint32 m_replyType;
+    BotTextTemplate m_compiled[MAX_LOCALES];
 };
 
 struct ChatReplyData
@@ -57,7 +96,8 @@ enum ChatReplyType
     REPLY_ATTACKER,
     REPLY_HELLO,
     REPLY_NAME,
-    REPLY_ADMIN_ABUSE
+    REPLY_ADMIN_ABUSE,
+    MAX_CHAT_REPLY_TYPE
 };
 
 class PlayerbotTextMgr
@@ -77,26 +117,31 @@ public:
         return &instance;
     }
 
-    std::string GetBotText(std::string name, std::map<std::string, std::string> placeholders);
-    std::string GetBotText(std::string name);
-    std::string GetBotText(ChatReplyType replyType, std::map<std::string, std::string> placeholders);
-    std::string GetBotText(ChatReplyType replyType, std::string name);
-    bool GetBotText(std::string name, std::string& text);
-    bool GetBotText(std::string name, std::string& text, std::map<std::string, std::string> placeholders);
-    std::string GetBotTextOrDefault(std::string name, std::string defaultText,
-                                    std::map<std::string, std::string> placeholders);
+    std::string GetBotText(std::string const& name, std::map<std::string, std::string> const& placeholders);
+    std::string GetBotText(std::string const& name);
+    std::string GetBotText(ChatReplyType replyType, std::map<std::string, std::string> const& placeholders);
+    std::string GetBotText(ChatReplyType replyType, std::string const& name);
+    bool GetBotText(std::string const& name, std::string& text);
+    bool GetBotText(std::string const& name, std::string& text, std::map<std::string, std::string> const& placeholders);
+    std::string GetBotTextOrDefault(std::string const& name, std::string defaultText,
+                                    std::map<std::string, std::string> const& placeholders);
     void LoadBotTexts();
     void LoadBotTextChance();
     static void replaceAll(std::string& str, const std::string& from, const std::string& to);
-    bool rollTextChance(std::string text);
+    bool rollTextChance(std::string const& text);
 
     uint32 GetLocalePriority();
     void AddLocalePriority(uint32 locale);
     void ResetLocalePriority();
 
 private:
-    std::map<std::string, std::vector<BotTextEntry>> botTexts;
-    std::map<std::string, uint32> botTextChance;
+    BotTextEntry const* SelectBotText(std::string const& name);
+    BotTextEntry const* SelectBotText(ChatReplyType replyType);
+
+    std::unordered_map<std::string, std::vector<BotTextEntry>> botTexts;
+    // indexes into botTexts["reply"] per reply type, built by LoadBotTexts()
+    std::vector<uint32> replyTexts[MAX_CHAT_REPLY_TYPE];
+    std::unordered_map<std::string, uint32> botTextChance;
     uint32 botTextLocalePriority[MAX_LOCALES];
 };
 
@@ -25,6 +25,7 @@
 #include "Metric.h"
 #include "PlayerScript.h"
 #include "PlayerbotAIConfig.h"
+#include "PlayerbotGearScore.h"
 #include "PlayerbotWorldThreadProcessor.h"
 #include "RandomPlayerbotMgr.h"
 #include "ScriptMgr.h"
@@ -89,7 +90,10 @@ public:
         PLAYERHOOK_CAN_PLAYER_USE_GUILD_CHAT,
         PLAYERHOOK_CAN_PLAYER_USE_CHANNEL_CHAT,
         PLAYERHOOK_ON_GIVE_EXP,
-        PLAYERHOOK_ON_BEFORE_TELEPORT
+        PLAYERHOOK_ON_BEFORE_TELEPORT,
+        PLAYERHOOK_ON_EQUIP,
+        PLAYERHOOK_ON_UNEQUIP_ITEM,
+        PLAYERHOOK_ON_STORE_NEW_ITEM
     }) {}
 
     void OnPlayerLogin(Player* player) override
@@ -143,6 +147,27 @@ public:
         return true;  // Allow teleport to continue
     }
 
+    void OnPlayerEquip(Player* player, Item* it, uint8 /*bag*/, uint8 slot, bool /*update*/) override
+    {
+        if (PlayerbotGearScoreCache* cache = PlayerbotGearScoreCache::Get(player))
+            cache->OnEquip(it, slot);
+    }
+
+    void OnPlayerUnequip(Player* player, Item* /*it*/) override
+    {
+        if (PlayerbotGearScoreCache* cache = PlayerbotGearScoreCache::Get(player))
+            cache->OnEquipmentChanged();
+    }
+
+    void OnPlayerStoreNewItem(Player* player, Item* item, uint32 /*count*/) override
+    {
+        if (PlayerbotGearScoreCache* cache = PlayerbotGearScoreCache::Get(player))
+            cache->OnInventoryChanged();
+
+        if (PlayerbotAI* botAI = GET_PLAYERBOT_AI(player))
+            botAI->OnItemStored(item->GetEntry());
+    }
+
     void OnPlayerAfterUpdate(Player* player, uint32 diff) override
     {
         if (PlayerbotAI* botAI = GET_PLAYERBOT_AI(player))
@@ -343,6 +368,8 @@ public:
     void OnUpdate(uint32 diff) override
     {
         sPlayerbotWorldProcessor->Update(diff);
+        sPlayerbotsMgr->Update();
+        sRandomPlayerbotMgr->ScaleBotActivity(diff);
         sRandomPlayerbotMgr->UpdateAI(diff);  // World thread only
     }
 };
@@ -468,9 +495,16 @@ public:
         }
 
         bgStrategies[bg->GetInstanceID()] = data;
+
+        sRandomPlayerbotMgr->OnBattlegroundStart(bg);
     }
 
-    void OnBattlegroundEnd(Battleground* bg, TeamId /*winnerTeam*/) override { bgStrategies.erase(bg->GetInstanceID()); }
+    void OnBattlegroundEnd(Battleground* bg, TeamId /*winnerTeam*/) override
+    {
+        bgStrategies.erase(bg->GetInstanceID());
+
+        sRandomPlayerbotMgr->OnBattlegroundEnd(bg);
+    }
 };
 
 void AddPlayerbotsScripts()
@@ -7,6 +7,8 @@
 
 #include "ItemTemplate.h"
 #include "LootValues.h"
+#include "PlayerbotCacheSnapshot.h"
+#include "PlayerbotStartupLoader.h"
 #include "Playerbots.h"
 
 char* strstri(char const* str1, char const* str2);
@@ -168,6 +170,90 @@ void RandomItemMgr::InitAfterAhBot()
     // BuildRarityCache();
 }
 
+void RandomItemMgr::AddStartupStages(PlayerbotStartupLoader& loader)
+{
+    if (sPlayerbotCacheSnapshot->IsLoaded())
+    {
+        // the stages keep their names so the ones depending on them do not care where the caches came from
+        loader.AddStage("item info cache",
+                        [this]()
+                        {
+                            if (LoadSnapshot())
+                                return;
+
+                            sPlayerbotCacheSnapshot->MarkStale();
+                            BuildItemInfoCache();
+                            BuildEquipCacheNew();
+                            BuildAmmoCache();
+                            BuildPotionCache();
+                            BuildFoodCache();
+                            BuildTradeCache();
+                        });
+        loader.AddStage("random item cache", [this]() { BuildRandomItemCache(); }, {"item info cache"});
+        return;
+    }
+
+    // builders fill their own caches from the read-only item and quest templates, except that the equip cache skips
+    // the test items the item info cache collects
+    loader.AddStage("item info cache", [this]() { BuildItemInfoCache(); });
+    loader.AddStage("equip cache", [this]() { BuildEquipCacheNew(); }, {"item info cache"});
+    loader.AddStage("ammo cache", [this]() { BuildAmmoCache(); });
+    loader.AddStage("potion cache", [this]() { BuildPotionCache(); });
+    loader.AddStage("food cache", [this]() { BuildFoodCache(); });
+    loader.AddStage("trade cache", [this]() { BuildTradeCache(); });
+    loader.AddStage("random item cache", [this]() { BuildRandomItemCache(); }, {"item info cache"});
+}
+
+bool RandomItemMgr::LoadSnapshot()
+{
+    if (!LoadWeightScales())
+        return false;
+
+    std::vector<uint32> testItems;
+    SnapshotIdTable equip, ammo, potion, food;
+    SnapshotIdLists trade;
+
+    PlayerbotCacheSnapshotSection section;
+    if (!sPlayerbotCacheSnapshot->GetSection(SNAPSHOT_SECTION_ITEM_FOR_TEST, section) || !section.GetIds(testItems) ||
+        !sPlayerbotCacheSnapshot->GetSection(SNAPSHOT_SECTION_EQUIP_CACHE, section) || !section.GetIdTable(equip) ||
+        !sPlayerbotCacheSnapshot->GetSection(SNAPSHOT_SECTION_AMMO_CACHE, section) || !section.GetIdTable(ammo) ||
+        !sPlayerbotCacheSnapshot->GetSection(SNAPSHOT_SECTION_POTION_CACHE, section) || !section.GetIdTable(potion) ||
+        !sPlayerbotCacheSnapshot->GetSection(SNAPSHOT_SECTION_FOOD_CACHE, section) || !section.GetIdTable(food) ||
+        !sPlayerbotCacheSnapshot->GetSection(SNAPSHOT_SECTION_TRADE_CACHE, section) || !section.GetIdLists(trade))
+    {
+        LOG_ERROR("playerbots", "Item caches missing from the cache snapshot, building them");
+        return false;
+    }
+
+    itemForTest.insert(testItems.begin(), testItems.end());
+    equipCacheNew.swap(equip);
+    ammoCache.swap(ammo);
+    potionCache.swap(potion);
+    foodCache.swap(food);
+    tradeCache.swap(trade);
+
+    LOG_INFO("server.loading", "Item caches loaded from snapshot: {} equipment levels, {} test items",
+             equipCacheNew.size(), itemForTest.size());
+    return true;
+}
+
+void RandomItemMgr::SaveSnapshot(PlayerbotCacheSnapshotWriter& writer)
+{
+    writer.BeginSection(SNAPSHOT_SECTION_ITEM_FOR_TEST);
+    writer.PutIds(std::vector<uint32>(itemForTest.begin(), itemForTest.end()));
+
+    writer.BeginSection(SNAPSHOT_SECTION_EQUIP_CACHE);
+    writer.PutIdTable(equipCacheNew);
+    writer.BeginSection(SNAPSHOT_SECTION_AMMO_CACHE);
+    writer.PutIdTable(ammoCache);
+    writer.BeginSection(SNAPSHOT_SECTION_POTION_CACHE);
+    writer.PutIdTable(potionCache);
+    writer.BeginSection(SNAPSHOT_SECTION_FOOD_CACHE);
+    writer.PutIdTable(foodCache);
+    writer.BeginSection(SNAPSHOT_SECTION_TRADE_CACHE);
+    writer.PutIdLists(tradeCache);
+}
+
 RandomItemMgr::~RandomItemMgr()
 {
     for (std::map<RandomItemType, RandomItemPredicate*>::iterator i = predicates.begin(); i != predicates.end(); ++i)
@@ -831,10 +917,8 @@ bool RandomItemMgr::CanEquipWeapon(uint8 clazz, ItemTemplate const* proto)
     return true;
 }
 
-void RandomItemMgr::BuildItemInfoCache()
+bool RandomItemMgr::LoadWeightScales()
 {
-    //uint32 maxLevel = sWorld->getIntConfig(CONFIG_MAX_PLAYER_LEVEL); //not used, line marked for removal.
-
     // load weightscales
     LOG_INFO("playerbots", "Loading weightscales info");
 
@@ -903,9 +987,19 @@ void RandomItemMgr::BuildItemInfoCache()
     if (m_weightScales[1].empty())
     {
         LOG_ERROR("playerbots", "Error loading item weight scales");
-        return;
+        return false;
     }
 
+    return true;
+}
+
+void RandomItemMgr::BuildItemInfoCache()
+{
+    //uint32 maxLevel = sWorld->getIntConfig(CONFIG_MAX_PLAYER_LEVEL); //not used, line marked for removal.
+
+    if (!LoadWeightScales())
+        return;
+
     // vendor items
     LOG_INFO("playerbots", "Loading vendor item list...");
 
@@ -16,6 +16,8 @@
 #include "ItemTemplate.h"
 
 class ChatHandler;
+class PlayerbotCacheSnapshotWriter;
+class PlayerbotStartupLoader;
 
 struct ItemTemplate;
 
@@ -146,6 +148,9 @@ public:
 public:
     void Init();
     void InitAfterAhBot();
+    // same caches as Init() and InitAfterAhBot(), as independent startup stages
+    void AddStartupStages(PlayerbotStartupLoader& loader);
+    void SaveSnapshot(PlayerbotCacheSnapshotWriter& writer);
     static bool HandleConsoleCommand(ChatHandler* handler, char const* args);
     RandomItemList Query(uint32 level, RandomItemType type, RandomItemPredicate* predicate);
     RandomItemList Query(uint32 level, uint8 clazz, uint8 slot, uint32 quality);
@@ -176,6 +181,8 @@ public:
     std::vector<uint32> GetCachedEquipments(uint32 requiredLevel, uint32 inventoryType);
 
 private:
+    bool LoadSnapshot();
+    bool LoadWeightScales();
     void BuildRandomItemCache();
     void BuildEquipCache();
     void BuildEquipCacheNew();
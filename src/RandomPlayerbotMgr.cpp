@@ -9,10 +9,12 @@
 
 #include <algorithm>
 #include <boost/thread/thread.hpp>
+#include <cmath>
 #include <cstdlib>
 #include <ctime>
 #include <iomanip>
 #include <random>
+#include <tuple>
 
 #include "AccountMgr.h"
 #include "AiFactory.h"
@@ -25,6 +27,7 @@
 #include "DBCStructure.h"
 #include "DatabaseEnv.h"
 #include "Define.h"
+#include "Engine.h"
 #include "FleeManager.h"
 #include "GameTime.h"
 #include "GridNotifiers.h"
@@ -40,6 +43,7 @@
 #include "Player.h"
 #include "PlayerbotAI.h"
 #include "PlayerbotAIConfig.h"
+#include "PlayerbotCacheSnapshot.h"
 #include "PlayerbotCommandServer.h"
 #include "PlayerbotFactory.h"
 #include "Playerbots.h"
@@ -48,6 +52,7 @@
 #include "RandomPlayerbotFactory.h"
 #include "ServerFacade.h"
 #include "SharedDefines.h"
+#include "StringFormat.h"
 #include "TravelMgr.h"
 #include "Unit.h"
 #include "UpdateTime.h"
@@ -219,25 +224,21 @@ RandomPlayerbotMgr::RandomPlayerbotMgr() : PlayerbotHolder(), processTicks(0)
 {
     playersLevel = sPlayerbotAIConfig->randombotStartingLevel;
 
+    // 1 ms over the target adds 0.5% pressure at once and 0.1% per second while it lasts
+    pid.adjust(0.5, 0.1, 0);
+    for (std::atomic<float>& scale : tickScale)
+        scale = 1.0f;
+
     if (sPlayerbotAIConfig->enabled || sPlayerbotAIConfig->randomBotAutologin)
     {
         sPlayerbotCommandServer->Start();
     }
 
-    BattlegroundData.clear();  // Clear here and here only.
-
     // Cleanup on server start: orphaned pet data that's often left behind by bot pets that no longer exist in the DB
     CharacterDatabase.Execute("DELETE FROM pet_aura WHERE guid NOT IN (SELECT id FROM character_pet)");
     CharacterDatabase.Execute("DELETE FROM pet_spell WHERE guid NOT IN (SELECT id FROM character_pet)");
     CharacterDatabase.Execute("DELETE FROM pet_spell_cooldown WHERE guid NOT IN (SELECT id FROM character_pet)");
 
-    for (int bracket = BG_BRACKET_ID_FIRST; bracket < MAX_BATTLEGROUND_BRACKETS; ++bracket)
-    {
-        for (int queueType = BATTLEGROUND_QUEUE_AV; queueType < MAX_BATTLEGROUND_QUEUE_TYPES; ++queueType)
-        {
-            BattlegroundData[queueType][bracket] = BattlegroundInfo();
-        }
-    }
     BgCheckTimer = 0;
     LfgCheckTimer = 0;
     PlayersCheckTimer = 0;
@@ -364,15 +365,6 @@ void RandomPlayerbotMgr::UpdateAIInternal(uint32 elapsed, bool /*minimal*/)
     if (!sPlayerbotAIConfig->randomBotAutologin || !sPlayerbotAIConfig->enabled)
         return;
 
-    /*if (sPlayerbotAIConfig->enablePrototypePerformanceDiff)
-    {
-        LOG_INFO("playerbots", "---------------------------------------");
-        LOG_INFO("playerbots",
-                 "PROTOTYPE: Playerbot performance enhancements are active. Issues and instability may occur.");
-        LOG_INFO("playerbots", "---------------------------------------");
-        ScaleBotActivity();
-    }*/
-
     uint32 maxAllowedBotCount = GetEventValue(0, "bot_count");
     if (!maxAllowedBotCount || (maxAllowedBotCount < sPlayerbotAIConfig->minRandomBots ||
                                 maxAllowedBotCount > sPlayerbotAIConfig->maxRandomBots))
@@ -537,25 +529,86 @@ void RandomPlayerbotMgr::UpdateAIInternal(uint32 elapsed, bool /*minimal*/)
     }
 }
 
-// void RandomPlayerbotMgr::ScaleBotActivity()
-//{
-//     float activityPercentage = getActivityPercentage();
-//
-//     // if (activityPercentage >= 100.0f || activityPercentage <= 0.0f) pid.reset(); //Stop integer buildup during
-//     // max/min activity
-//
-//     //    % increase/decrease                   wanted diff                                         , avg diff
-//     float activityPercentageMod = pid.calculate(
-//         sRandomPlayerbotMgr->GetPlayers().empty() ? sPlayerbotAIConfig->diffEmpty :
-//         sPlayerbotAIConfig->diffWithPlayer, sWorldUpdateTime.GetAverageUpdateTime());
-//
-//     activityPercentage = activityPercentageMod + 50;
-//
-//     // Cap the percentage between 0 and 100.
-//     activityPercentage = std::max(0.0f, std::min(100.0f, activityPercentage));
-//
-//     setActivityPercentage(activityPercentage);
-// }
+void RandomPlayerbotMgr::ScaleBotActivity(uint32 elapsed)
+{
+    if (!sPlayerbotAIConfig->tickScale)
+    {
+        // switched off by a config reload, release the throttled bots
+        if (tickScalePressure > 0.0f)
+        {
+            pid.reset();
+            tickScalePressure = 0.0f;
+            for (std::atomic<float>& scale : tickScale)
+                scale = 1.0f;
+        }
+
+        return;
+    }
+
+    tickScaleTimer += elapsed;
+    if (tickScaleTimer < 1000)
+        return;
+
+    // the pid runs on a fixed one second step, a late world tick does not count twice
+    tickScaleTimer = 0;
+
+    tickScaleTarget = players.empty() ? sPlayerbotAIConfig->tickScaleTargetDiffEmpty
+                                      : sPlayerbotAIConfig->tickScaleTargetDiff;
+    double measured = sWorldUpdateTime.GetAverageUpdateTime();
+
+    // inside the deadband the integral holds, so the pressure neither creeps up nor decays around the target
+    if (std::abs(measured - tickScaleTarget) <= sPlayerbotAIConfig->tickScaleDeadband)
+        measured = tickScaleTarget;
+
+    //                     avg diff, wanted diff
+    float pressure = pid.calculate(measured, tickScaleTarget) / 100.0f;
+
+    // only publish real changes, bots re-read their scale every tick
+    if (std::abs(pressure - tickScalePressure) < 0.05f && (pressure > 0.0f || tickScalePressure == 0.0f))
+        return;
+
+    tickScalePressure = pressure;
+    for (uint8 tier = 0; tier < MAX_ACTIVITY_TIER; ++tier)
+    {
+        float const maxScale = sPlayerbotAIConfig->tickScaleMaxStretch[tier] / 100.0f;
+        tickScale[tier] = 1.0f + pressure * std::max(0.0f, maxScale - 1.0f);
+    }
+
+    LOG_DEBUG("playerbots", "Tick scale: world update {} ms, target {} ms, pressure {:.0f}%",
+              sWorldUpdateTime.GetAverageUpdateTime(), tickScaleTarget, pressure * 100.0f);
+}
+
+std::vector<std::string> RandomPlayerbotMgr::GetTickScaleReport()
+{
+    static char const* tierNames[MAX_ACTIVITY_TIER] = {"master", "battleground", "combat", "idle", "resting"};
+
+    std::vector<std::string> report;
+    if (!sPlayerbotAIConfig->tickScale)
+    {
+        report.push_back("Tick scale: disabled");
+        return report;
+    }
+
+    report.push_back(Acore::StringFormat("Tick scale: world update {} ms avg, target {} ms, pressure {:.0f}%",
+                                         sWorldUpdateTime.GetAverageUpdateTime(), tickScaleTarget,
+                                         tickScalePressure * 100.0f));
+
+    PlayerbotStatsSnapshot const stats = sPlayerbotStats->GetSnapshot();
+    uint32 throttled = 0;
+    for (uint8 tier = 0; tier < MAX_ACTIVITY_TIER; ++tier)
+    {
+        float const scale = GetTickScale(BotActivityTier(tier));
+        if (scale > 1.0f)
+            throttled += stats.perActivityTier[tier];
+
+        report.push_back(Acore::StringFormat("    {}: {} bots, react delay x{:.2f}, {} iterations per action",
+                                             tierNames[tier], stats.perActivityTier[tier], scale,
+                                             PlayerbotAI::GetIterationsPerTick(scale)));
+    }
+
+    report.push_back(Acore::StringFormat("    Throttled: {} of {} bots", throttled, stats.online));
+    return report;
+}
 
 // Assigns accounts as RNDbot accounts (type 1) based on MaxRandomBots and EnablePeriodicOnlineOffline and its ratio,
 // and assigns accounts as AddClass accounts (type 2) based AddClassAccountPoolSize. Type 1 and 2 assignments are
@@ -964,6 +1017,61 @@ std::vector<uint32> parseBrackets(const std::string& str)
     return brackets;
 }
 
+// Demand counted by CheckBgQueue before it replaces the shared ledger
+struct BattlegroundCount
+{
+    std::vector<uint32> bgInstances;
+    std::vector<uint32> ratedArenaInstances;
+    std::vector<uint32> skirmishArenaInstances;
+    uint32 minLevel = 0;
+    uint32 maxLevel = 0;
+    uint32 activeRatedArenaQueue = 0;
+    uint32 activeSkirmishArenaQueue = 0;
+    uint32 activeBgQueue = 0;
+    uint32 ratedArenaBotCount = 0;
+    uint32 skirmishArenaBotCount = 0;
+    uint32 bgHordeBotCount = 0;
+    uint32 bgAllianceBotCount = 0;
+    uint32 ratedArenaPlayerCount = 0;
+    uint32 skirmishArenaPlayerCount = 0;
+    uint32 bgHordePlayerCount = 0;
+    uint32 bgAlliancePlayerCount = 0;
+};
+
+static std::atomic<uint32>* GetInstanceCounter(Battleground* bg)
+{
+    BattlegroundQueueTypeId queueTypeId = BattlegroundMgr::BGQueueTypeId(bg->GetBgTypeID(), bg->GetArenaType());
+    BattlegroundBracketId bracketId = bg->GetBracketId();
+    if (queueTypeId >= MAX_BATTLEGROUND_QUEUE_TYPES || bracketId >= MAX_BATTLEGROUND_BRACKETS)
+        return nullptr;
+
+    BattlegroundInfo& bgInfo = sRandomPlayerbotMgr->BattlegroundData[queueTypeId][bracketId];
+    if (!bg->isArena())
+        return &bgInfo.bgInstanceCount;
+
+    return bg->isRated() ? &bgInfo.ratedArenaInstanceCount : &bgInfo.skirmishArenaInstanceCount;
+}
+
+// Random battlegrounds count under the queue of their map until the next CheckBgQueue moves them back
+void RandomPlayerbotMgr::OnBattlegroundStart(Battleground* bg)
+{
+    if (std::atomic<uint32>* instanceCount = GetInstanceCounter(bg))
+        ++*instanceCount;
+}
+
+void RandomPlayerbotMgr::OnBattlegroundEnd(Battleground* bg)
+{
+    std::atomic<uint32>* instanceCount = GetInstanceCounter(bg);
+    if (!instanceCount)
+        return;
+
+    // the count may have been reconciled since the start, never wrap below zero
+    uint32 count = instanceCount->load();
+    while (count && !instanceCount->compare_exchange_weak(count, count - 1))
+    {
+    }
+}
+
 void RandomPlayerbotMgr::CheckBgQueue()
 {
     if (!BgCheckTimer)
@@ -982,15 +1090,8 @@ void RandomPlayerbotMgr::CheckBgQueue()
 
     LOG_DEBUG("playerbots", "Checking BG Queue...");
 
-    // Initialize Battleground Data (do not clear here)
-
-    for (int bracket = BG_BRACKET_ID_FIRST; bracket < MAX_BATTLEGROUND_BRACKETS; ++bracket)
-    {
-        for (int queueType = BATTLEGROUND_QUEUE_AV; queueType < MAX_BATTLEGROUND_QUEUE_TYPES; ++queueType)
-        {
-            BattlegroundData[queueType][bracket] = BattlegroundInfo();
-        }
-    }
+    // Counted aside and published at the end, bots keep reading and adjusting the ledger meanwhile
+    std::array<std::array<BattlegroundCount, MAX_BATTLEGROUND_BRACKETS>, MAX_BATTLEGROUND_QUEUE_TYPES> counts;
 
     // Process real players and populate Battleground Data with player/queue count
     // Opens a queue for bots to join
@@ -1021,8 +1122,8 @@ void RandomPlayerbotMgr::CheckBgQueue()
 
             // If player is allowed, populate the BattlegroundData with the appropriate level requirements
             BattlegroundBracketId bracketId = pvpDiff->GetBracketId();
-            BattlegroundData[queueTypeId][bracketId].minLevel = pvpDiff->minLevel;
-            BattlegroundData[queueTypeId][bracketId].maxLevel = pvpDiff->maxLevel;
+            counts[queueTypeId][bracketId].minLevel = pvpDiff->minLevel;
+            counts[queueTypeId][bracketId].maxLevel = pvpDiff->maxLevel;
 
             // Arena logic
             bool isRated = false;
@@ -1041,17 +1142,17 @@ void RandomPlayerbotMgr::CheckBgQueue()
                     isRated = true;
 
                 if (isRated)
-                    BattlegroundData[queueTypeId][bracketId].ratedArenaPlayerCount++;
+                    counts[queueTypeId][bracketId].ratedArenaPlayerCount++;
                 else
-                    BattlegroundData[queueTypeId][bracketId].skirmishArenaPlayerCount++;
+                    counts[queueTypeId][bracketId].skirmishArenaPlayerCount++;
             }
             // BG Logic
             else
             {
                 if (teamId == TEAM_ALLIANCE)
-                    BattlegroundData[queueTypeId][bracketId].bgAlliancePlayerCount++;
+                    counts[queueTypeId][bracketId].bgAlliancePlayerCount++;
                 else
-                    BattlegroundData[queueTypeId][bracketId].bgHordePlayerCount++;
+                    counts[queueTypeId][bracketId].bgHordePlayerCount++;
 
                 // If a player has joined the BG, update the instance count in BattlegroundData (for consistency)
                 if (player->InBattleground())
@@ -1059,12 +1160,10 @@ void RandomPlayerbotMgr::CheckBgQueue()
                     std::vector<uint32>* instanceIds = nullptr;
                     uint32 instanceId = player->GetBattleground()->GetInstanceID();
 
-                    instanceIds = &BattlegroundData[queueTypeId][bracketId].bgInstances;
+                    instanceIds = &counts[queueTypeId][bracketId].bgInstances;
                     if (instanceIds &&
                         std::find(instanceIds->begin(), instanceIds->end(), instanceId) == instanceIds->end())
                         instanceIds->push_back(instanceId);
-
-                    BattlegroundData[queueTypeId][bracketId].bgInstanceCount = instanceIds->size();
                 }
             }
 
@@ -1073,13 +1172,13 @@ void RandomPlayerbotMgr::CheckBgQueue()
                 if (BattlegroundMgr::BGArenaType(queueTypeId))
                 {
                     if (isRated)
-                        BattlegroundData[queueTypeId][bracketId].activeRatedArenaQueue = 1;
+                        counts[queueTypeId][bracketId].activeRatedArenaQueue = 1;
                     else
-                        BattlegroundData[queueTypeId][bracketId].activeSkirmishArenaQueue = 1;
+                        counts[queueTypeId][bracketId].activeSkirmishArenaQueue = 1;
                 }
                 else
                 {
-                    BattlegroundData[queueTypeId][bracketId].activeBgQueue = 1;
+                    counts[queueTypeId][bracketId].activeBgQueue = 1;
                 }
             }
         }
@@ -1110,8 +1209,8 @@ void RandomPlayerbotMgr::CheckBgQueue()
                 continue;
 
             BattlegroundBracketId bracketId = pvpDiff->GetBracketId();
-            BattlegroundData[queueTypeId][bracketId].minLevel = pvpDiff->minLevel;
-            BattlegroundData[queueTypeId][bracketId].maxLevel = pvpDiff->maxLevel;
+            counts[queueTypeId][bracketId].minLevel = pvpDiff->minLevel;
+            counts[queueTypeId][bracketId].maxLevel = pvpDiff->maxLevel;
 
             if (uint8 arenaType = BattlegroundMgr::BGArenaType(queueTypeId))
             {
@@ -1128,60 +1227,44 @@ void RandomPlayerbotMgr::CheckBgQueue()
                     isRated = true;
 
                 if (isRated)
-                    BattlegroundData[queueTypeId][bracketId].ratedArenaBotCount++;
+                    counts[queueTypeId][bracketId].ratedArenaBotCount++;
                 else
-                    BattlegroundData[queueTypeId][bracketId].skirmishArenaBotCount++;
+                    counts[queueTypeId][bracketId].skirmishArenaBotCount++;
             }
             else
             {
                 if (teamId == TEAM_ALLIANCE)
-                    BattlegroundData[queueTypeId][bracketId].bgAllianceBotCount++;
+                    counts[queueTypeId][bracketId].bgAllianceBotCount++;
                 else
-                    BattlegroundData[queueTypeId][bracketId].bgHordeBotCount++;
+                    counts[queueTypeId][bracketId].bgHordeBotCount++;
             }
 
             if (bot->InBattleground())
             {
                 std::vector<uint32>* instanceIds = nullptr;
                 uint32 instanceId = bot->GetBattleground()->GetInstanceID();
-                bool isArena = false;
-                bool isRated = false;
 
                 // Arena logic
                 if (bot->InArena())
                 {
-                    isArena = true;
                     if (bot->GetBattleground()->isRated())
                     {
-                        isRated = true;
-                        instanceIds = &BattlegroundData[queueTypeId][bracketId].ratedArenaInstances;
+                        instanceIds = &counts[queueTypeId][bracketId].ratedArenaInstances;
                     }
                     else
                     {
-                        instanceIds = &BattlegroundData[queueTypeId][bracketId].skirmishArenaInstances;
+                        instanceIds = &counts[queueTypeId][bracketId].skirmishArenaInstances;
                     }
                 }
                 // BG Logic
                 else
                 {
-                    instanceIds = &BattlegroundData[queueTypeId][bracketId].bgInstances;
+                    instanceIds = &counts[queueTypeId][bracketId].bgInstances;
                 }
 
                 if (instanceIds &&
                     std::find(instanceIds->begin(), instanceIds->end(), instanceId) == instanceIds->end())
                     instanceIds->push_back(instanceId);
-
-                if (isArena)
-                {
-                    if (isRated)
-                        BattlegroundData[queueTypeId][bracketId].ratedArenaInstanceCount = instanceIds->size();
-                    else
-                        BattlegroundData[queueTypeId][bracketId].skirmishArenaInstanceCount = instanceIds->size();
-                }
-                else
-                {
-                    BattlegroundData[queueTypeId][bracketId].bgInstanceCount = instanceIds->size();
-                }
             }
         }
     }
@@ -1206,24 +1289,26 @@ void RandomPlayerbotMgr::CheckBgQueue()
         std::vector<uint32> abBrackets = parseBrackets(sPlayerbotAIConfig->randomBotAutoJoinABBrackets);
         std::vector<uint32> wsBrackets = parseBrackets(sPlayerbotAIConfig->randomBotAutoJoinWSBrackets);
 
-        // Check both bgInstanceCount / bgInstances.size
-        // to help counter against potentional inconsistencies
         auto updateRatedArenaInstanceCount = [&](uint32 queueType, uint32 bracket, uint32 minCount)
         {
-            if (BattlegroundData[queueType][bracket].activeRatedArenaQueue == 0 &&
-                BattlegroundData[queueType][bracket].ratedArenaInstanceCount < minCount &&
-                BattlegroundData[queueType][bracket].ratedArenaInstances.size() < minCount)
-                BattlegroundData[queueType][bracket].activeRatedArenaQueue = 1;
+            if (bracket >= MAX_BATTLEGROUND_BRACKETS)
+                return;
+
+            if (counts[queueType][bracket].activeRatedArenaQueue == 0 &&
+                counts[queueType][bracket].ratedArenaInstances.size() < minCount)
+                counts[queueType][bracket].activeRatedArenaQueue = 1;
         };
 
         auto updateBGInstanceCount = [&](uint32 queueType, std::vector<uint32> brackets, uint32 minCount)
         {
             for (uint32 bracket : brackets)
             {
-                if (BattlegroundData[queueType][bracket].activeBgQueue == 0 &&
-                    BattlegroundData[queueType][bracket].bgInstanceCount < minCount &&
-                    BattlegroundData[queueType][bracket].bgInstances.size() < minCount)
-                    BattlegroundData[queueType][bracket].activeBgQueue = 1;
+                if (bracket >= MAX_BATTLEGROUND_BRACKETS)
+                    continue;
+
+                if (counts[queueType][bracket].activeBgQueue == 0 &&
+                    counts[queueType][bracket].bgInstances.size() < minCount)
+                    counts[queueType][bracket].activeBgQueue = 1;
             }
         };
 
@@ -1243,22 +1328,46 @@ void RandomPlayerbotMgr::CheckBgQueue()
         updateBGInstanceCount(BATTLEGROUND_QUEUE_WS, wsBrackets, randomBotAutoJoinBGWSCount);
     }
 
+    for (uint32 queueType = 0; queueType < MAX_BATTLEGROUND_QUEUE_TYPES; ++queueType)
+    {
+        for (uint32 bracket = 0; bracket < MAX_BATTLEGROUND_BRACKETS; ++bracket)
+        {
+            BattlegroundCount const& count = counts[queueType][bracket];
+            BattlegroundInfo& bgInfo = BattlegroundData[queueType][bracket];
+
+            bgInfo.bgInstanceCount = count.bgInstances.size();
+            bgInfo.ratedArenaInstanceCount = count.ratedArenaInstances.size();
+            bgInfo.skirmishArenaInstanceCount = count.skirmishArenaInstances.size();
+            bgInfo.minLevel = count.minLevel;
+            bgInfo.maxLevel = count.maxLevel;
+            bgInfo.activeRatedArenaQueue = count.activeRatedArenaQueue;
+            bgInfo.activeSkirmishArenaQueue = count.activeSkirmishArenaQueue;
+            bgInfo.activeBgQueue = count.activeBgQueue;
+            bgInfo.ratedArenaBotCount = count.ratedArenaBotCount;
+            bgInfo.skirmishArenaBotCount = count.skirmishArenaBotCount;
+            bgInfo.bgHordeBotCount = count.bgHordeBotCount;
+            bgInfo.bgAllianceBotCount = count.bgAllianceBotCount;
+            bgInfo.ratedArenaPlayerCount = count.ratedArenaPlayerCount;
+            bgInfo.skirmishArenaPlayerCount = count.skirmishArenaPlayerCount;
+            bgInfo.bgHordePlayerCount = count.bgHordePlayerCount;
+            bgInfo.bgAlliancePlayerCount = count.bgAlliancePlayerCount;
+        }
+    }
+
     LogBattlegroundInfo();
 }
 
 void RandomPlayerbotMgr::LogBattlegroundInfo()
 {
-    for (auto const& queueTypePair : BattlegroundData)
+    for (uint8 queueType = 0; queueType < MAX_BATTLEGROUND_QUEUE_TYPES; ++queueType)
     {
-        uint8 queueType = queueTypePair.first;
 
         BattlegroundQueueTypeId queueTypeId = BattlegroundQueueTypeId(queueType);
 
         if (uint8 type = BattlegroundMgr::BGArenaType(queueTypeId))
         {
-            for (auto const& bracketIdPair : queueTypePair.second)
+            for (BattlegroundInfo const& bgInfo : BattlegroundData[queueType])
             {
-                auto& bgInfo = bracketIdPair.second;
                 if (bgInfo.minLevel == 0)
                     continue;
                 LOG_INFO("playerbots",
@@ -1268,10 +1377,11 @@ void RandomPlayerbotMgr::LogBattlegroundInfo()
                          : type == ARENA_TYPE_3v3 ? "3v3"
                                                   : "5v5",
                          std::to_string(bgInfo.minLevel) + "-" + std::to_string(bgInfo.maxLevel),
-                         bgInfo.skirmishArenaPlayerCount, bgInfo.ratedArenaPlayerCount, bgInfo.skirmishArenaBotCount,
-                         bgInfo.ratedArenaBotCount, bgInfo.skirmishArenaPlayerCount + bgInfo.skirmishArenaBotCount,
-                         bgInfo.ratedArenaPlayerCount + bgInfo.ratedArenaBotCount, bgInfo.skirmishArenaInstanceCount,
-                         bgInfo.ratedArenaInstanceCount);
+                         bgInfo.skirmishArenaPlayerCount.load(), bgInfo.ratedArenaPlayerCount.load(),
+                         bgInfo.skirmishArenaBotCount.load(), bgInfo.ratedArenaBotCount.load(),
+                         bgInfo.skirmishArenaPlayerCount + bgInfo.skirmishArenaBotCount,
+                         bgInfo.ratedArenaPlayerCount + bgInfo.ratedArenaBotCount,
+                         bgInfo.skirmishArenaInstanceCount.load(), bgInfo.ratedArenaInstanceCount.load());
             }
             continue;
         }
@@ -1306,23 +1416,49 @@ void RandomPlayerbotMgr::LogBattlegroundInfo()
                 break;
         }
 
-        for (auto const& bracketIdPair : queueTypePair.second)
+        for (BattlegroundInfo const& bgInfo : BattlegroundData[queueType])
         {
-            auto& bgInfo = bracketIdPair.second;
             if (bgInfo.minLevel == 0)
                 continue;
 
             LOG_INFO("playerbots",
                      "BG:{} {}: Player ({}:{}) Bot ({}:{}) Total (A:{} H:{}), Instances {}, Active Queue: {}", _bgType,
                      std::to_string(bgInfo.minLevel) + "-" + std::to_string(bgInfo.maxLevel),
-                     bgInfo.bgAlliancePlayerCount, bgInfo.bgHordePlayerCount, bgInfo.bgAllianceBotCount,
-                     bgInfo.bgHordeBotCount, bgInfo.bgAlliancePlayerCount + bgInfo.bgAllianceBotCount,
-                     bgInfo.bgHordePlayerCount + bgInfo.bgHordeBotCount, bgInfo.bgInstanceCount, bgInfo.activeBgQueue);
+                     bgInfo.bgAlliancePlayerCount.load(), bgInfo.bgHordePlayerCount.load(),
+                     bgInfo.bgAllianceBotCount.load(), bgInfo.bgHordeBotCount.load(),
+                     bgInfo.bgAlliancePlayerCount + bgInfo.bgAllianceBotCount,
+                     bgInfo.bgHordePlayerCount + bgInfo.bgHordeBotCount, bgInfo.bgInstanceCount.load(),
+                     bgInfo.activeBgQueue.load());
         }
     }
     LOG_DEBUG("playerbots", "BG Queue check finished");
 }
 
+// bots that claimed a role get this long to send their join before an empty lfg state releases the claim
+static constexpr time_t LFG_CLAIM_JOIN_TIME = 30;
+
+static uint8 GetLfgRoleSlot(uint32 roleMask)
+{
+    if (roleMask & lfg::PLAYER_ROLE_TANK)
+        return 0;
+
+    if (roleMask & lfg::PLAYER_ROLE_HEALER)
+        return 1;
+
+    return 2;
+}
+
+// takes the role of a queued member out of the missing roles, tank and healer first
+static void TakeLfgRole(std::array<uint8, 3>& missing, uint32 roleMask)
+{
+    if ((roleMask & lfg::PLAYER_ROLE_TANK) && missing[0])
+        --missing[0];
+    else if ((roleMask & lfg::PLAYER_ROLE_HEALER) && missing[1])
+        --missing[1];
+    else if (missing[2])
+        --missing[2];
+}
+
 void RandomPlayerbotMgr::CheckLfgQueue()
 {
     if (!LfgCheckTimer || time(nullptr) > (LfgCheckTimer + 30))
@@ -1330,10 +1466,8 @@ void RandomPlayerbotMgr::CheckLfgQueue()
 
     LOG_DEBUG("playerbots", "Checking LFG Queue...");
 
-    // Clear LFG list
-    LfgDungeons[TEAM_ALLIANCE].clear();
-    LfgDungeons[TEAM_HORDE].clear();
-
+    std::vector<LfgDemand> demands;
+    std::unordered_set<ObjectGuid> counted;
     for (std::vector<Player*>::iterator i = players.begin(); i != players.end(); ++i)
     {
         Player* player = *i;
@@ -1342,23 +1476,108 @@ void RandomPlayerbotMgr::CheckLfgQueue()
 
         Group* group = player->GetGroup();
         ObjectGuid guid = group ? group->GetGUID() : player->GetGUID();
+        if (!counted.insert(guid).second)
+            continue;
 
         lfg::LfgState gState = sLFGMgr->GetState(guid);
-        if (gState != lfg::LFG_STATE_NONE && gState < lfg::LFG_STATE_DUNGEON)
+        if (gState == lfg::LFG_STATE_NONE || gState >= lfg::LFG_STATE_DUNGEON)
+            continue;
+
+        LfgDemand demand;
+        demand.queued = guid;
+        demand.teamId = player->GetTeamId();
+
+        lfg::LfgDungeonSet const& dList = sLFGMgr->GetSelectedDungeons(player->GetGUID());
+        for (lfg::LfgDungeonSet::const_iterator itr = dList.begin(); itr != dList.end(); ++itr)
         {
-            lfg::LfgDungeonSet const& dList = sLFGMgr->GetSelectedDungeons(player->GetGUID());
-            for (lfg::LfgDungeonSet::const_iterator itr = dList.begin(); itr != dList.end(); ++itr)
-            {
-                lfg::LFGDungeonData const* dungeon = sLFGMgr->GetLFGDungeon(*itr);
-                if (!dungeon)
-                    continue;
+            lfg::LFGDungeonData const* dungeon = sLFGMgr->GetLFGDungeon(*itr);
+            if (!dungeon)
+                continue;
+
+            demand.dungeons.push_back(dungeon->id);
+        }
+
+        if (demand.dungeons.empty())
+            continue;
 
-                LfgDungeons[player->GetTeamId()].push_back(dungeon->id);
+        // a dungeon group is a tank, a healer and three damage dealers
+        demand.missing = {1, 1, 3};
+        if (group)
+        {
+            for (GroupReference* ref = group->GetFirstMember(); ref; ref = ref->next())
+            {
+                if (Player* member = ref->GetSource())
+                    TakeLfgRole(demand.missing, sLFGMgr->GetRoles(member->GetGUID()));
             }
         }
+        else
+            TakeLfgRole(demand.missing, sLFGMgr->GetRoles(player->GetGUID()));
+
+        demands.push_back(std::move(demand));
+    }
+
+    time_t now = time(nullptr);
+    uint32 claimed = 0;
+
+    std::lock_guard<std::mutex> guard(lfgDemandLock);
+
+    // claims of bots still joining or queued keep their role
+    for (LfgDemand& demand : demands)
+    {
+        auto previous = std::find_if(lfgDemands.begin(), lfgDemands.end(),
+                                     [&demand](LfgDemand const& old) { return old.queued == demand.queued; });
+        if (previous == lfgDemands.end())
+            continue;
+
+        for (LfgDemand::Claim const& claim : previous->claims)
+        {
+            if (!demand.missing[claim.slot])
+                continue;
+
+            if (now - claim.at > LFG_CLAIM_JOIN_TIME && sLFGMgr->GetState(claim.bot) == lfg::LFG_STATE_NONE)
+                continue;
+
+            --demand.missing[claim.slot];
+            demand.claims.push_back(claim);
+            ++claimed;
+        }
+    }
+
+    lfgDemands.swap(demands);
+
+    LOG_DEBUG("playerbots", "LFG Queue check finished: {} waiting, {} roles claimed by bots", lfgDemands.size(),
+              claimed);
+}
+
+bool RandomPlayerbotMgr::ClaimLfgSlot(Player* bot, uint32 roleMask, std::function<bool(uint32)> const& suitable,
+                                      std::vector<uint32>& dungeons)
+{
+    uint8 slot = GetLfgRoleSlot(roleMask);
+
+    std::lock_guard<std::mutex> guard(lfgDemandLock);
+
+    // fill one waiting group before the next
+    for (LfgDemand& demand : lfgDemands)
+    {
+        if (demand.teamId != bot->GetTeamId() || !demand.missing[slot])
+            continue;
+
+        dungeons.clear();
+        for (uint32 dungeonId : demand.dungeons)
+        {
+            if (suitable(dungeonId))
+                dungeons.push_back(dungeonId);
+        }
+
+        if (dungeons.empty())
+            continue;
+
+        --demand.missing[slot];
+        demand.claims.push_back({bot->GetGUID(), slot, time(nullptr)});
+        return true;
     }
 
-    LOG_DEBUG("playerbots", "LFG Queue check finished");
+    return false;
 }
 
 void RandomPlayerbotMgr::CheckPlayers()
@@ -2118,6 +2337,297 @@ void RandomPlayerbotMgr::PrepareTeleportCache()
     LOG_INFO("playerbots", ">> {} banker locations for level collected.", collected_locs);
 }
 
+static void PutLocationsPerLevel(PlayerbotCacheSnapshotWriter& writer,
+                                 std::map<uint8, std::vector<WorldLocation>> const& cache)
+{
+    writer.PutUInt32(cache.size());
+    for (auto const& [level, locs] : cache)
+    {
+        writer.PutUInt32(level);
+        writer.PutUInt32(locs.size());
+        for (WorldLocation const& loc : locs)
+        {
+            writer.PutUInt32(loc.GetMapId());
+            writer.PutFloat(loc.GetPositionX());
+            writer.PutFloat(loc.GetPositionY());
+            writer.PutFloat(loc.GetPositionZ());
+            writer.PutFloat(loc.GetOrientation());
+        }
+    }
+}
+
+static bool GetLocationsPerLevel(PlayerbotCacheSnapshotSection& section,
+                                 std::map<uint8, std::vector<WorldLocation>>& cache)
+{
+    uint32 levels = section.GetUInt32();
+    for (uint32 i = 0; i < levels && !section.IsFailed(); ++i)
+    {
+        std::vector<WorldLocation>& locs = cache[(uint8)section.GetUInt32()];
+        uint32 count = section.GetUInt32();
+        for (uint32 j = 0; j < count && !section.IsFailed(); ++j)
+        {
+            uint32 mapId = section.GetUInt32();
+            float x = section.GetFloat();
+            float y = section.GetFloat();
+            float z = section.GetFloat();
+            float o = section.GetFloat();
+            locs.emplace_back(mapId, x, y, z, o);
+        }
+    }
+
+    return !section.IsFailed();
+}
+
+void RandomPlayerbotMgr::SaveTeleportSnapshot(PlayerbotCacheSnapshotWriter& writer)
+{
+    writer.BeginSection(SNAPSHOT_SECTION_TELEPORT_CACHE);
+    PutLocationsPerLevel(writer, locsPerLevelCache);
+
+    writer.BeginSection(SNAPSHOT_SECTION_STARTER_CACHE);
+    PutLocationsPerLevel(writer, allianceStarterPerLevelCache);
+    PutLocationsPerLevel(writer, hordeStarterPerLevelCache);
+    writer.PutIds(allianceFlightMasterCache);
+    writer.PutIds(hordeFlightMasterCache);
+
+    writer.BeginSection(SNAPSHOT_SECTION_BANKER_CACHE);
+    writer.PutUInt32(bankerLocsPerLevelCache.size());
+    for (auto const& [level, bankers] : bankerLocsPerLevelCache)
+    {
+        writer.PutUInt32(level);
+        writer.PutUInt32(bankers.size());
+        for (BankerLocation const& bLoc : bankers)
+        {
+            writer.PutUInt32(bLoc.entry);
+            writer.PutUInt32(bLoc.loc.GetMapId());
+            writer.PutFloat(bLoc.loc.GetPositionX());
+            writer.PutFloat(bLoc.loc.GetPositionY());
+            writer.PutFloat(bLoc.loc.GetPositionZ());
+            writer.PutFloat(bLoc.loc.GetOrientation());
+        }
+    }
+}
+
+bool RandomPlayerbotMgr::LoadTeleportSnapshot()
+{
+    std::map<uint8, std::vector<WorldLocation>> locs, allianceStarter, hordeStarter;
+    std::vector<uint32> allianceFlightMasters, hordeFlightMasters;
+    std::map<uint8, std::vector<BankerLocation>> bankers;
+
+    PlayerbotCacheSnapshotSection section;
+    if (!sPlayerbotCacheSnapshot->GetSection(SNAPSHOT_SECTION_TELEPORT_CACHE, section) ||
+        !GetLocationsPerLevel(section, locs))
+        return false;
+
+    if (!sPlayerbotCacheSnapshot->GetSection(SNAPSHOT_SECTION_STARTER_CACHE, section) ||
+        !GetLocationsPerLevel(section, allianceStarter) || !GetLocationsPerLevel(section, hordeStarter) ||
+        !section.GetIds(allianceFlightMasters) || !section.GetIds(hordeFlightMasters))
+        return false;
+
+    if (!sPlayerbotCacheSnapshot->GetSection(SNAPSHOT_SECTION_BANKER_CACHE, section))
+        return false;
+
+    uint32 levels = section.GetUInt32();
+    for (uint32 i = 0; i < levels && !section.IsFailed(); ++i)
+    {
+        std::vector<BankerLocation>& levelBankers = bankers[(uint8)section.GetUInt32()];
+        uint32 count = section.GetUInt32();
+        for (uint32 j = 0; j < count && !section.IsFailed(); ++j)
+        {
+            BankerLocation bLoc;
+            bLoc.entry = section.GetUInt32();
+            uint32 mapId = section.GetUInt32();
+            float x = section.GetFloat();
+            float y = section.GetFloat();
+            float z = section.GetFloat();
+            float o = section.GetFloat();
+            bLoc.loc = WorldLocation(mapId, x, y, z, o);
+            levelBankers.push_back(bLoc);
+        }
+    }
+
+    if (section.IsFailed())
+        return false;
+
+    locsPerLevelCache.swap(locs);
+    allianceStarterPerLevelCache.swap(allianceStarter);
+    hordeStarterPerLevelCache.swap(hordeStarter);
+    allianceFlightMasterCache.swap(allianceFlightMasters);
+    hordeFlightMasterCache.swap(hordeFlightMasters);
+    bankerLocsPerLevelCache.swap(bankers);
+
+    for (auto const& [level, levelBankers] : bankerLocsPerLevelCache)
+    {
+        for (BankerLocation const& bLoc : levelBankers)
+            bankerEntryToLocation[bLoc.entry] = bLoc.loc;
+    }
+
+    // the brackets come from config only and are cheap to prepare
+    if (sPlayerbotAIConfig->enableNewRpgStrategy)
+        PrepareZone2LevelBracket();
+
+    LOG_INFO("playerbots", ">> Random teleport caches loaded from snapshot: {} levels, {} banker levels",
+             locsPerLevelCache.size(), bankerLocsPerLevelCache.size());
+    return true;
+}
+
+void RpgLocationGrid::Add(WorldLocation const& loc, uint32 zoneId)
+{
+    cells[GetCellKey(GetCell(loc.GetPositionX()), GetCell(loc.GetPositionY()))].push_back({loc, zoneId});
+    ++count;
+}
+
+RpgLocationGrid const* RandomPlayerbotMgr::GetRpgLocations(RpgLocationIndex const& index, uint8 level,
+                                                           uint32 mapId) const
+{
+    auto levelLocations = index.find(level);
+    if (levelLocations == index.end())
+        return nullptr;
+
+    auto mapLocations = levelLocations->second.find(mapId);
+    if (mapLocations == levelLocations->second.end())
+        return nullptr;
+
+    return &mapLocations->second;
+}
+
+void RandomPlayerbotMgr::PrepareRpgLocationIndex()
+{
+    // locations repeat across the levels around theirs, look each zone up once
+    std::map<std::tuple<uint32, float, float, float>, uint32> zones;
+    auto buildIndex = [&zones](std::map<uint8, std::vector<WorldLocation>> const& cache, RpgLocationIndex& index)
+    {
+        index.clear();
+        for (auto const& [level, locs] : cache)
+        {
+            for (WorldLocation const& loc : locs)
+            {
+                auto const key = std::make_tuple(loc.GetMapId(), loc.GetPositionX(), loc.GetPositionY(),
+                                                 loc.GetPositionZ());
+                auto zone = zones.find(key);
+                if (zone == zones.end())
+                    zone = zones.emplace(key, sMapMgr->GetZoneId(PHASEMASK_NORMAL, loc.GetMapId(),
+                                                                 loc.GetPositionX(), loc.GetPositionY(),
+                                                                 loc.GetPositionZ())).first;
+
+                index[level][loc.GetMapId()].Add(loc, zone->second);
+            }
+        }
+    };
+
+    buildIndex(locsPerLevelCache, rpgGrindLocations);
+    buildIndex(allianceStarterPerLevelCache, rpgAllianceCampLocations);
+    buildIndex(hordeStarterPerLevelCache, rpgHordeCampLocations);
+
+    LOG_INFO("playerbots", ">> {} rpg locations indexed.", zones.size());
+}
+
+void RandomPlayerbotMgr::PrepareRpgTaxiIndex()
+{
+    uint32 maxLevel = sWorld->getIntConfig(CONFIG_MAX_PLAYER_LEVEL);
+    uint32 destinations = 0;
+
+    for (TeamId teamId : {TEAM_ALLIANCE, TEAM_HORDE})
+    {
+        std::vector<uint32> const& flightMasterGuids =
+            teamId == TEAM_ALLIANCE ? allianceFlightMasterCache : hordeFlightMasterCache;
+
+        rpgFlightMasters[teamId].clear();
+        rpgTaxiDestinations[teamId].clear();
+
+        std::unordered_set<uint32> fromNodes;
+        for (uint32 guid : flightMasterGuids)
+        {
+            CreatureData const* data = sObjectMgr->GetCreatureData(guid);
+            if (!data)
+                continue;
+
+            uint32 taxiNode = sObjectMgr->GetNearestTaxiNode(data->posX, data->posY, data->posZ, data->mapid, teamId);
+            if (!taxiNode)
+                continue;
+
+            rpgFlightMasters[teamId][data->mapid].push_back({guid, data->posX, data->posY, data->posZ, taxiNode});
+            fromNodes.insert(taxiNode);
+        }
+
+        for (uint32 fromNode : fromNodes)
+        {
+            TaxiNodesEntry const* from = sTaxiNodesStore.LookupEntry(fromNode);
+            if (!from)
+                continue;
+
+            for (uint32 i = 1; i < sTaxiNodesStore.GetNumRows(); ++i)
+            {
+                if (fromNode == i)
+                    continue;
+
+                TaxiNodesEntry const* node = sTaxiNodesStore.LookupEntry(i);
+
+                // check map
+                if (!node || node->map_id != from->map_id ||
+                    (!node->MountCreatureID[teamId == TEAM_ALLIANCE ? 1 : 0]))  // dk flight
+                    continue;
+
+                // check path
+                uint32 path, cost;
+                sObjectMgr->GetTaxiPath(fromNode, i, path, cost);
+                if (!path)
+                    continue;
+
+                // check area level, capitals suit every level
+                uint32 nodeZoneId = sMapMgr->GetZoneId(PHASEMASK_NORMAL, node->map_id, node->x, node->y, node->z);
+                uint32 low = 1, high = maxLevel;
+                AreaTableEntry const* zone = sAreaTableStore.LookupEntry(nodeZoneId);
+                if (!zone || !(zone->flags & AREA_FLAG_CAPITAL))
+                {
+                    auto itr = zone2LevelBracket.find(nodeZoneId);
+                    if (itr == zone2LevelBracket.end())
+                        continue;
+
+                    low = itr->second.low;
+                    high = std::min(itr->second.high, maxLevel);
+                }
+
+                for (uint32 level = low; level <= high; ++level)
+                    rpgTaxiDestinations[teamId][std::make_pair(fromNode, (uint8)level)].push_back(i);
+
+                ++destinations;
+            }
+        }
+    }
+
+    LOG_INFO("playerbots", ">> {} rpg flight routes indexed.", destinations);
+}
+
+void RandomPlayerbotMgr::FindRpgFlightMasters(TeamId teamId, uint32 mapId, float x, float y, float range,
+                                              std::vector<RpgFlightMaster const*>& flightMasters) const
+{
+    auto mapFlightMasters = rpgFlightMasters[teamId].find(mapId);
+    if (mapFlightMasters == rpgFlightMasters[teamId].end())
+        return;
+
+    std::vector<std::pair<float, RpgFlightMaster const*>> inRange;
+    float const maxDist = range * range;
+    for (RpgFlightMaster const& flightMaster : mapFlightMasters->second)
+    {
+        float dx = flightMaster.x - x, dy = flightMaster.y - y;
+        float dist = dx * dx + dy * dy;
+        if (dist <= maxDist)
+            inRange.emplace_back(dist, &flightMaster);
+    }
+
+    std::sort(inRange.begin(), inRange.end(), [](auto const& lhs, auto const& rhs) { return lhs.first < rhs.first; });
+
+    for (auto const& [dist, flightMaster] : inRange)
+        flightMasters.push_back(flightMaster);
+}
+
+std::vector<uint32> const* RandomPlayerbotMgr::GetRpgTaxiDestinations(TeamId teamId, uint32 fromNode,
+                                                                      uint8 level) const
+{
+    auto destinations = rpgTaxiDestinations[teamId].find(std::make_pair(fromNode, level));
+    return destinations == rpgTaxiDestinations[teamId].end() ? nullptr : &destinations->second;
+}
+
 void RandomPlayerbotMgr::PrepareAddclassCache()
 {
     // Using accounts marked as type 2 (AddClass)
@@ -2160,7 +2670,19 @@ void RandomPlayerbotMgr::Init()
 
     if (sPlayerbotAIConfig->enabled)
     {
-        sRandomPlayerbotMgr->PrepareTeleportCache();
+        if (!sPlayerbotCacheSnapshot->IsLoaded() || !sRandomPlayerbotMgr->LoadTeleportSnapshot())
+        {
+            if (sPlayerbotCacheSnapshot->IsLoaded())
+                sPlayerbotCacheSnapshot->MarkStale();
+
+            sRandomPlayerbotMgr->PrepareTeleportCache();
+        }
+
+        if (sPlayerbotAIConfig->enableNewRpgStrategy)
+        {
+            sRandomPlayerbotMgr->PrepareRpgLocationIndex();
+            sRandomPlayerbotMgr->PrepareRpgTaxiIndex();
+        }
     }
 
     if (sPlayerbotAIConfig->randomBotJoinBG)
@@ -3019,6 +3541,9 @@ void RandomPlayerbotMgr::OnBotLoginInternal(Player* const bot)
     {
         bot->RemovePlayerFlag(PLAYER_FLAGS_NO_XP_GAIN);
     }
+
+    if (PlayerbotAI* botAI = GET_PLAYERBOT_AI(bot))
+        sPlayerbotStats->Track(botAI);
 }
 
 void RandomPlayerbotMgr::OnPlayerLogin(Player* player)
@@ -3129,152 +3654,29 @@ Player* RandomPlayerbotMgr::GetRandomPlayer()
 
 void RandomPlayerbotMgr::PrintStats()
 {
-    printStatsTimer = time(nullptr);
-    LOG_INFO("playerbots", "Random Bots Stats: {} online", playerBots.size());
-
-    std::map<uint8, uint32> alliance, horde;
-    for (uint32 i = 0; i < 10; ++i)
-    {
-        alliance[i] = 0;
-        horde[i] = 0;
-    }
-
-    std::map<uint8, uint32> perRace;
-    std::map<uint8, uint32> perClass;
+    time_t const now = time(nullptr);
+    time_t const elapsed = printStatsTimer ? std::max<time_t>(1, now - printStatsTimer) : 0;
+    printStatsTimer = now;
 
-    std::map<uint8, uint32> lvlPerRace;
-    std::map<uint8, uint32> lvlPerClass;
-    for (uint8 race = RACE_HUMAN; race < MAX_RACES; ++race)
-    {
-        perRace[race] = 0;
-        lvlPerRace[race] = 0;
-    }
+    PlayerbotStatsSnapshot const stats = sPlayerbotStats->GetSnapshot();
+    LOG_INFO("playerbots", "Random Bots Stats: {} online", stats.online);
 
-    for (uint8 cls = CLASS_WARRIOR; cls < MAX_CLASSES; ++cls)
-    {
-        perClass[cls] = 0;
-        lvlPerClass[cls] = 0;
-    }
-
-    uint32 dps = 0;
-    uint32 heal = 0;
-    uint32 tank = 0;
-    uint32 active = 0;
-    uint32 update = 0;
-    uint32 randomize = 0;
-    uint32 teleport = 0;
-    uint32 changeStrategy = 0;
-    uint32 dead = 0;
-    uint32 combat = 0;
-    // uint32 revive = 0; //not used, line marked for removal.
-    uint32 inFlight = 0;
-    uint32 moving = 0;
-    uint32 mounted = 0;
-    uint32 inBg = 0;
-    uint32 rest = 0;
-    uint32 engine_noncombat = 0;
-    uint32 engine_combat = 0;
-    uint32 engine_dead = 0;
-    std::unordered_map<NewRpgStatus, int> rpgStatusCount;
-    // static NewRpgStatistic rpgStasticTotal;
-    std::unordered_map<uint32, int> zoneCount;
     uint8 maxBotLevel = 0;
-    for (PlayerBotMap::iterator i = playerBots.begin(); i != playerBots.end(); ++i)
+    for (uint32 i = 0; i < MAX_STATS_LEVEL; ++i)
     {
-        Player* bot = i->second;
-        if (IsAlliance(bot->getRace()))
-            ++alliance[bot->GetLevel()];
-        else
-            ++horde[bot->GetLevel()];
-        maxBotLevel = std::max(maxBotLevel, bot->GetLevel());
-
-        ++perRace[bot->getRace()];
-        ++perClass[bot->getClass()];
-
-        lvlPerClass[bot->getClass()] += bot->GetLevel();
-        lvlPerRace[bot->getRace()] += bot->GetLevel();
-
-        PlayerbotAI* botAI = GET_PLAYERBOT_AI(bot);
-        if (botAI->AllowActivity())
-            ++active;
-
-        if (botAI->GetAiObjectContext()->GetValue<bool>("random bot update")->Get())
-            ++update;
-
-        uint32 botId = bot->GetGUID().GetCounter();
-        if (!GetEventValue(botId, "randomize"))
-            ++randomize;
-
-        if (!GetEventValue(botId, "teleport"))
-            ++teleport;
-
-        if (!GetEventValue(botId, "change_strategy"))
-            ++changeStrategy;
-
-        if (bot->isDead())
-        {
-            ++dead;
-            // if (!GetEventValue(botId, "dead"))
-            //++revive;
-        }
-        if (bot->IsInCombat())
-        {
-            ++combat;
-        }
-        if (bot->isMoving())
-        {
-            ++moving;
-        }
-        if (bot->IsInFlight())
-        {
-            ++inFlight;
-        }
-        if (bot->IsMounted())
-        {
-            ++mounted;
-        }
-        if (bot->InBattleground() || bot->InArena())
-        {
-            ++inBg;
-        }
-        if (bot->HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_RESTING))
-        {
-            ++rest;
-        }
-        if (botAI->GetState() == BOT_STATE_NON_COMBAT)
-            ++engine_noncombat;
-        else if (botAI->GetState() == BOT_STATE_COMBAT)
-            ++engine_combat;
-        else
-            ++engine_dead;
-
-        if (botAI->IsHeal(bot, true))
-            ++heal;
-        else if (botAI->IsTank(bot, true))
-            ++tank;
-        else
-            ++dps;
-
-        zoneCount[bot->GetZoneId()]++;
-
-        if (sPlayerbotAIConfig->enableNewRpgStrategy)
-        {
-            rpgStatusCount[botAI->rpgInfo.status]++;
-            rpgStasticTotal += botAI->rpgStatistic;
-            botAI->rpgStatistic = NewRpgStatistic();
-        }
+        if (stats.alliancePerLevel[i] || stats.hordePerLevel[i])
+            maxBotLevel = i;
     }
 
     LOG_INFO("playerbots", "Bots level:");
-    // uint32 maxLevel = sWorld->getIntConfig(CONFIG_MAX_PLAYER_LEVEL);
     uint32_t currentAlliance = 0, currentHorde = 0;
     uint32_t step = std::max(1, static_cast<int>((maxBotLevel + 4) / 8));
     uint32_t from = 1;
 
     for (uint8 i = 1; i <= maxBotLevel; ++i)
     {
-        currentAlliance += alliance[i];
-        currentHorde += horde[i];
+        currentAlliance += stats.alliancePerLevel[i];
+        currentHorde += stats.hordePerLevel[i];
 
         if (((i + 1) % step == 0) || i == maxBotLevel)
         {
@@ -3289,47 +3691,40 @@ void RandomPlayerbotMgr::PrintStats()
     LOG_INFO("playerbots", "Bots race:");
     for (uint8 race = RACE_HUMAN; race < MAX_RACES; ++race)
     {
-        if (perRace[race])
+        if (stats.perRace[race])
         {
-            uint32 lvl = lvlPerRace[race] * 10 / perRace[race];
+            uint32 lvl = stats.levelSumPerRace[race] * 10 / stats.perRace[race];
             float flvl = lvl / 10.0f;
-            LOG_INFO("playerbots", "    {}: {}, avg lvl: {}", ChatHelper::FormatRace(race).c_str(), perRace[race],
-                     flvl);
+            LOG_INFO("playerbots", "    {}: {}, avg lvl: {}", ChatHelper::FormatRace(race).c_str(),
+                     stats.perRace[race], flvl);
         }
     }
 
     LOG_INFO("playerbots", "Bots class:");
     for (uint8 cls = CLASS_WARRIOR; cls < MAX_CLASSES; ++cls)
     {
-        if (perClass[cls])
+        if (stats.perClass[cls])
         {
-            uint32 lvl = lvlPerClass[cls] * 10 / perClass[cls];
+            uint32 lvl = stats.levelSumPerClass[cls] * 10 / stats.perClass[cls];
             float flvl = lvl / 10.0f;
-            LOG_INFO("playerbots", "    {}: {}, avg lvl: {}", ChatHelper::FormatClass(cls).c_str(), perClass[cls],
-                     flvl);
+            LOG_INFO("playerbots", "    {}: {}, avg lvl: {}", ChatHelper::FormatClass(cls).c_str(),
+                     stats.perClass[cls], flvl);
         }
     }
 
     LOG_INFO("playerbots", "Bots role:");
-    LOG_INFO("playerbots", "    tank: {}, heal: {}, dps: {}", tank, heal, dps);
+    LOG_INFO("playerbots", "    tank: {}, heal: {}, dps: {}", stats.perRole[STATS_ROLE_TANK],
+             stats.perRole[STATS_ROLE_HEAL], stats.perRole[STATS_ROLE_DPS]);
 
     LOG_INFO("playerbots", "Bots status:");
-    LOG_INFO("playerbots", "    Active: {}", active);
-    LOG_INFO("playerbots", "    Moving: {}", moving);
-
-    // LOG_INFO("playerbots", "Bots to:");
-    // LOG_INFO("playerbots", "    update: {}", update);
-    // LOG_INFO("playerbots", "    randomize: {}", randomize);
-    // LOG_INFO("playerbots", "    teleport: {}", teleport);
-    // LOG_INFO("playerbots", "    change_strategy: {}", changeStrategy);
-    // LOG_INFO("playerbots", "    revive: {}", revive);
-
-    LOG_INFO("playerbots", "    In flight: {}", inFlight);
-    LOG_INFO("playerbots", "    On mount: {}", mounted);
-    LOG_INFO("playerbots", "    In combat: {}", combat);
-    LOG_INFO("playerbots", "    In BG: {}", inBg);
-    LOG_INFO("playerbots", "    In Rest: {}", rest);
-    LOG_INFO("playerbots", "    Dead: {}", dead);
+    LOG_INFO("playerbots", "    Active: {}", stats.perFlag[STATS_FLAG_ACTIVE]);
+    LOG_INFO("playerbots", "    Moving: {}", stats.perFlag[STATS_FLAG_MOVING]);
+    LOG_INFO("playerbots", "    In flight: {}", stats.perFlag[STATS_FLAG_IN_FLIGHT]);
+    LOG_INFO("playerbots", "    On mount: {}", stats.perFlag[STATS_FLAG_MOUNTED]);
+    LOG_INFO("playerbots", "    In combat: {}", stats.perFlag[STATS_FLAG_COMBAT]);
+    LOG_INFO("playerbots", "    In BG: {}", stats.perFlag[STATS_FLAG_IN_BG]);
+    LOG_INFO("playerbots", "    In Rest: {}", stats.perFlag[STATS_FLAG_RESTING]);
+    LOG_INFO("playerbots", "    Dead: {}", stats.perFlag[STATS_FLAG_DEAD]);
 
     if (sPlayerbotAIConfig->enableNewRpgStrategy)
     {
@@ -3337,17 +3732,40 @@ void RandomPlayerbotMgr::PrintStats()
         LOG_INFO("playerbots",
                  "    Idle: {}, Rest: {}, GoGrind: {}, GoCamp: {}, MoveRandom: {}, MoveNpc: {}, DoQuest: {}, "
                  "TravelFlight: {}",
-                 rpgStatusCount[RPG_IDLE], rpgStatusCount[RPG_REST], rpgStatusCount[RPG_GO_GRIND],
-                 rpgStatusCount[RPG_GO_CAMP], rpgStatusCount[RPG_WANDER_RANDOM], rpgStatusCount[RPG_WANDER_NPC],
-                 rpgStatusCount[RPG_DO_QUEST], rpgStatusCount[RPG_TRAVEL_FLIGHT]);
+                 stats.perRpgStatus[RPG_IDLE], stats.perRpgStatus[RPG_REST], stats.perRpgStatus[RPG_GO_GRIND],
+                 stats.perRpgStatus[RPG_GO_CAMP], stats.perRpgStatus[RPG_WANDER_RANDOM],
+                 stats.perRpgStatus[RPG_WANDER_NPC], stats.perRpgStatus[RPG_DO_QUEST],
+                 stats.perRpgStatus[RPG_TRAVEL_FLIGHT]);
 
         LOG_INFO("playerbots", "Bots total quests:");
-        LOG_INFO("playerbots", "    Accepted: {}, Rewarded: {}, Dropped: {}", rpgStasticTotal.questAccepted,
-                 rpgStasticTotal.questRewarded, rpgStasticTotal.questDropped);
+        LOG_INFO("playerbots", "    Accepted: {}, Rewarded: {}, Dropped: {}", stats.quests[STATS_QUEST_ACCEPTED],
+                 stats.quests[STATS_QUEST_REWARDED], stats.quests[STATS_QUEST_DROPPED]);
+    }
+
+    LOG_INFO("playerbots", "Bots engine:");
+    LOG_INFO("playerbots", "    Non-combat: {}, Combat: {}, Dead: {}", stats.perEngineState[BOT_STATE_NON_COMBAT],
+             stats.perEngineState[BOT_STATE_COMBAT], stats.perEngineState[BOT_STATE_DEAD]);
+    LOG_INFO("playerbots", "    Shared engine templates: {}", EngineTemplate::GetCachedCount());
+
+    if (sPlayerbotAIConfig->tickScale)
+    {
+        for (std::string const& line : GetTickScaleReport())
+            LOG_INFO("playerbots", "{}", line);
     }
 
-    LOG_INFO("playerbots", "Bots engine:", dead);
-    LOG_INFO("playerbots", "    Non-combat: {}, Combat: {}, Dead: {}", engine_noncombat, engine_combat, engine_dead);
+    if (elapsed && stats.online)
+    {
+        double const botSeconds = double(elapsed) * stats.online;
+        LOG_INFO("playerbots", "Bots spell checks:");
+        LOG_INFO("playerbots", "    Per bot-second: {:.1f} checks, {:.1f} memo hits, {:.1f} spell probes",
+                 (stats.castChecks - printStatsCastChecks) / botSeconds,
+                 (stats.castCheckMemoHits - printStatsCastCheckMemoHits) / botSeconds,
+                 (stats.spellProbes - printStatsSpellProbes) / botSeconds);
+    }
+
+    printStatsCastChecks = stats.castChecks;
+    printStatsCastCheckMemoHits = stats.castCheckMemoHits;
+    printStatsSpellProbes = stats.spellProbes;
 }
 
 double RandomPlayerbotMgr::GetBuyMultiplier(Player* bot)
@@ -3420,6 +3838,22 @@ uint32 RandomPlayerbotMgr::GetTradeDiscount(Player* bot, Player* master)
 
 std::string const RandomPlayerbotMgr::HandleRemoteCommand(std::string const request)
 {
+    if (request == "stats")
+    {
+        PlayerbotStatsSnapshot const stats = sPlayerbotStats->GetSnapshot();
+        std::ostringstream out;
+        out << "online=" << stats.online << ",active=" << stats.perFlag[STATS_FLAG_ACTIVE]
+            << ",combat=" << stats.perFlag[STATS_FLAG_COMBAT] << ",dead=" << stats.perFlag[STATS_FLAG_DEAD]
+            << ",moving=" << stats.perFlag[STATS_FLAG_MOVING] << ",bg=" << stats.perFlag[STATS_FLAG_IN_BG]
+            << ",engine_combat=" << stats.perEngineState[BOT_STATE_COMBAT]
+            << ",engine_noncombat=" << stats.perEngineState[BOT_STATE_NON_COMBAT]
+            << ",engine_dead=" << stats.perEngineState[BOT_STATE_DEAD];
+        for (uint8 status = RPG_STATUS_START; status < RPG_STATUS_END; ++status)
+            out << ",rpg" << uint32(status) << "=" << stats.perRpgStatus[status];
+
+        return out.str();
+    }
+
     std::string::const_iterator pos = std::find(request.begin(), request.end(), ',');
     if (pos == request.end())
     {
@@ -6,41 +6,145 @@
 #ifndef _PLAYERBOT_RANDOMPLAYERBOTMGR_H
 #define _PLAYERBOT_RANDOMPLAYERBOTMGR_H
 
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "DBCEnums.h"
 #include "NewRpgInfo.h"
 #include "ObjectGuid.h"
 #include "PlayerbotMgr.h"
+#include "Position.h"
+#include "SharedDefines.h"
+
+class PlayerbotCacheSnapshotWriter;
 
+/**
+ * @brief Battleground and arena demand of one queue type and bracket
+ *
+ * Read and adjusted by the map threads when bots decide to queue, so every counter is atomic. Bots joining add
+ * themselves, battlegrounds starting and ending adjust the instance counts, and CheckBgQueue reconciles everything
+ * with the queued players and bots every 35 seconds.
+ */
 struct BattlegroundInfo
 {
-    std::vector<uint32> bgInstances;
-    std::vector<uint32> ratedArenaInstances;
-    std::vector<uint32> skirmishArenaInstances;
-    uint32 bgInstanceCount = 0;
-    uint32 ratedArenaInstanceCount = 0;
-    uint32 skirmishArenaInstanceCount = 0;
-    uint32 minLevel = 0;
-    uint32 maxLevel = 0;
-    uint32 activeRatedArenaQueue = 0;     // 0 = Inactive, 1 = Active
-    uint32 activeSkirmishArenaQueue = 0;  // 0 = Inactive, 1 = Active
-    uint32 activeBgQueue = 0;             // 0 = Inactive, 1 = Active
+    std::atomic<uint32> bgInstanceCount{0};
+    std::atomic<uint32> ratedArenaInstanceCount{0};
+    std::atomic<uint32> skirmishArenaInstanceCount{0};
+    std::atomic<uint32> minLevel{0};
+    std::atomic<uint32> maxLevel{0};
+    std::atomic<uint32> activeRatedArenaQueue{0};     // 0 = Inactive, 1 = Active
+    std::atomic<uint32> activeSkirmishArenaQueue{0};  // 0 = Inactive, 1 = Active
+    std::atomic<uint32> activeBgQueue{0};             // 0 = Inactive, 1 = Active
 
     // Bots (Arena)
-    uint32 ratedArenaBotCount = 0;
-    uint32 skirmishArenaBotCount = 0;
+    std::atomic<uint32> ratedArenaBotCount{0};
+    std::atomic<uint32> skirmishArenaBotCount{0};
 
     // Bots (Battleground)
-    uint32 bgHordeBotCount = 0;
-    uint32 bgAllianceBotCount = 0;
+    std::atomic<uint32> bgHordeBotCount{0};
+    std::atomic<uint32> bgAllianceBotCount{0};
 
     // Players (Arena)
-    uint32 ratedArenaPlayerCount = 0;
-    uint32 skirmishArenaPlayerCount = 0;
+    std::atomic<uint32> ratedArenaPlayerCount{0};
+    std::atomic<uint32> skirmishArenaPlayerCount{0};
 
     // Players (Battleground)
-    uint32 bgHordePlayerCount = 0;
-    uint32 bgAlliancePlayerCount = 0;
+    std::atomic<uint32> bgHordePlayerCount{0};
+    std::atomic<uint32> bgAlliancePlayerCount{0};
 };
 
+struct RpgLocation
+{
+    WorldLocation loc;
+    // zone of the location in the normal phase
+    uint32 zoneId;
+};
+
+/**
+ * @brief Rpg destinations of one level on one map, bucketed in square cells
+ *
+ * Built once at startup and read only afterwards, so map threads query it without a lock. A range query only visits
+ * the cells overlapping the range instead of every destination of the level.
+ */
+class RpgLocationGrid
+{
+public:
+    void Add(WorldLocation const& loc, uint32 zoneId);
+
+    // calls visitor for every location of the cells overlapping the range, callers still check the exact distance
+    template <class Visitor>
+    void VisitRange(float x, float y, float range, Visitor&& visitor) const
+    {
+        int32 const minX = GetCell(x - range), maxX = GetCell(x + range);
+        int32 const minY = GetCell(y - range), maxY = GetCell(y + range);
+        for (int32 cellX = minX; cellX <= maxX; ++cellX)
+        {
+            for (int32 cellY = minY; cellY <= maxY; ++cellY)
+            {
+                auto cell = cells.find(GetCellKey(cellX, cellY));
+                if (cell == cells.end())
+                    continue;
+
+                for (RpgLocation const& location : cell->second)
+                    visitor(location);
+            }
+        }
+    }
+
+    size_t size() const { return count; }
+
+private:
+    static constexpr float CELL_SIZE = 500.0f;
+
+    static int32 GetCell(float coord) { return int32(std::floor(coord / CELL_SIZE)); }
+    static uint64 GetCellKey(int32 cellX, int32 cellY) { return (uint64(uint32(cellX)) << 32) | uint32(cellY); }
+
+    std::unordered_map<uint64, std::vector<RpgLocation>> cells;
+    size_t count = 0;
+};
+
+// level, map
+typedef std::map<uint8, std::unordered_map<uint32, RpgLocationGrid>> RpgLocationIndex;
+
+struct RpgFlightMaster
+{
+    ObjectGuid::LowType guid;
+    float x, y, z;
+    // taxi node the flight master serves
+    uint32 taxiNode;
+};
+
+/**
+ * @brief Roles a real player or group waiting in the dungeon finder still misses
+ *
+ * Rebuilt by CheckLfgQueue from the queued real players. Random bots claim a missing role before they queue, so only as
+ * many bots join as the waiting groups can take instead of every idle bot of a fitting level.
+ */
+struct LfgDemand
+{
+    struct Claim
+    {
+        ObjectGuid bot;
+        uint8 slot;
+        time_t at;
+    };
+
+    // player or group waiting
+    ObjectGuid queued;
+    TeamId teamId;
+    std::vector<uint32> dungeons;
+    // tank, healer, damage
+    std::array<uint8, 3> missing;
+    std::vector<Claim> claims;
+};
+
+class Battleground;
 class ChatHandler;
 class PerformanceMonitorOperation;
 class WorldLocation;
@@ -89,6 +193,17 @@ private:
     botPIDImpl* pimpl;
 };
 
+// How important a bot's next tick is, the tick scaler stretches the less important tiers first
+enum BotActivityTier : uint8
+{
+    ACTIVITY_TIER_MASTER = 0,
+    ACTIVITY_TIER_BATTLEGROUND = 1,
+    ACTIVITY_TIER_COMBAT = 2,
+    ACTIVITY_TIER_IDLE = 3,
+    ACTIVITY_TIER_RESTING = 4,
+    MAX_ACTIVITY_TIER
+};
+
 class RandomPlayerbotMgr : public PlayerbotHolder
 {
 public:
@@ -148,11 +263,15 @@ public:
     ObjectGuid const GetBattleMasterGUID(Player* bot, BattlegroundTypeId bgTypeId);
     CreatureData const* GetCreatureDataByEntry(uint32 entry);
     void LoadBattleMastersCache();
-    std::map<uint32, std::map<uint32, BattlegroundInfo>> BattlegroundData;
+    std::array<std::array<BattlegroundInfo, MAX_BATTLEGROUND_BRACKETS>, MAX_BATTLEGROUND_QUEUE_TYPES> BattlegroundData;
     std::map<uint32, std::map<uint32, std::map<TeamId, uint32>>> VisualBots;
     std::map<uint32, std::map<uint32, std::map<uint32, uint32>>> Supporters;
-    std::map<TeamId, std::vector<uint32>> LfgDungeons;
+    // claims a missing role of a waiting real player or group, dungeons are the waiting ones the bot is suitable for
+    bool ClaimLfgSlot(Player* bot, uint32 roleMask, std::function<bool(uint32)> const& suitable,
+                      std::vector<uint32>& dungeons);
     void CheckBgQueue();
+    void OnBattlegroundStart(Battleground* bg);
+    void OnBattlegroundEnd(Battleground* bg);
     void CheckLfgQueue();
     void CheckPlayers();
     void LogBattlegroundInfo();
@@ -165,16 +284,37 @@ public:
     float getActivityMod() { return activityMod; }
     float getActivityPercentage() { return activityMod * 100.0f; }
     void setActivityPercentage(float percentage) { activityMod = percentage / 100.0f; }
+    // World thread, feeds the average world update time into the tick scale controller
+    void ScaleBotActivity(uint32 elapsed);
+    // Stretch applied to the react delay of a tier, 1 when the world keeps up with the target update time
+    float GetTickScale(BotActivityTier tier) const { return tickScale[tier].load(std::memory_order_relaxed); }
+    std::vector<std::string> GetTickScaleReport();
     static uint8 GetTeamClassIdx(bool isAlliance, uint8 claz) { return isAlliance * 20 + claz; }
 
     void PrepareAddclassCache();
     void PrepareZone2LevelBracket();
     void PrepareTeleportCache();
+    void SaveTeleportSnapshot(PlayerbotCacheSnapshotWriter& writer);
+    bool LoadTeleportSnapshot();
     void Init();
     std::map<uint8, std::unordered_set<ObjectGuid>> addclassCache;
     std::map<uint8, std::vector<WorldLocation>> locsPerLevelCache;
     std::map<uint8, std::vector<WorldLocation>> allianceStarterPerLevelCache;
     std::map<uint8, std::vector<WorldLocation>> hordeStarterPerLevelCache;
+    // the level caches above bucketed per map for the new rpg strategy
+    void PrepareRpgLocationIndex();
+    RpgLocationGrid const* GetRpgLocations(RpgLocationIndex const& index, uint8 level, uint32 mapId) const;
+    RpgLocationIndex rpgGrindLocations;
+    RpgLocationIndex rpgAllianceCampLocations;
+    RpgLocationIndex rpgHordeCampLocations;
+    // flight masters per map and taxi destinations per start node and level, for each team
+    void PrepareRpgTaxiIndex();
+    // flight masters within range, nearest first
+    void FindRpgFlightMasters(TeamId teamId, uint32 mapId, float x, float y, float range,
+                              std::vector<RpgFlightMaster const*>& flightMasters) const;
+    std::vector<uint32> const* GetRpgTaxiDestinations(TeamId teamId, uint32 fromNode, uint8 level) const;
+    std::array<std::unordered_map<uint32, std::vector<RpgFlightMaster>>, PVP_TEAMS_COUNT> rpgFlightMasters;
+    std::array<std::map<std::pair<uint32, uint8>, std::vector<uint32>>, PVP_TEAMS_COUNT> rpgTaxiDestinations;
     std::vector<uint32> allianceFlightMasterCache;
     std::vector<uint32> hordeFlightMasterCache;
     struct LevelBracket {
@@ -197,12 +337,18 @@ protected:
     void OnBotLoginInternal(Player* const bot) override;
 
 private:
-    // pid values are set in constructor
-    botPID pid = botPID(1, 50, -50, 0, 0, 0);
+    // pid values are set in constructor, the output is the tick scale pressure in percent
+    botPID pid = botPID(1, 100, 0, 0, 0, 0);
     float activityMod = 0.25;
+    uint32 tickScaleTimer = 0;
+    // rebuilt by the world thread, claimed from map threads
+    std::mutex lfgDemandLock;
+    std::vector<LfgDemand> lfgDemands;
+    uint32 tickScaleTarget = 0;
+    float tickScalePressure = 0.0f;
+    std::atomic<float> tickScale[MAX_ACTIVITY_TIER];
     bool _isBotInitializing = true;
     bool _isBotLogging = true;
-    NewRpgStatistic rpgStasticTotal;
     uint32 GetEventValue(uint32 bot, std::string const event);
     std::string const GetEventData(uint32 bot, std::string const event);
     uint32 SetEventValue(uint32 bot, std::string const event, uint32 value, uint32 validIn,
@@ -215,6 +361,9 @@ private:
     time_t RealPlayerLastTimeSeen = 0;
     time_t DelayLoginBotsTimer;
     time_t printStatsTimer;
+    uint64 printStatsCastChecks = 0;
+    uint64 printStatsCastCheckMemoHits = 0;
+    uint64 printStatsSpellProbes = 0;
     uint32 AddRandomBots();
     bool ProcessBot(uint32 bot);
     void ScheduleRandomize(uint32 bot, uint32 time);
@@ -236,8 +385,6 @@ private:
     // Account lists
     std::vector<uint32> rndBotTypeAccounts;             // Accounts marked as RNDbot (type 1)
     std::vector<uint32> addClassTypeAccounts;           // Accounts marked as AddClass (type 2)
-
-    //void ScaleBotActivity();      // Deprecated function
 };
 
 #define sRandomPlayerbotMgr RandomPlayerbotMgr::instance()
@@ -10,6 +10,7 @@
 
 #include "BudgetValues.h"
 #include "PathGenerator.h"
+#include "PlayerbotCacheSnapshot.h"
 #include "Playerbots.h"
 #include "ServerFacade.h"
 #include "TransportMgr.h"
@@ -2308,6 +2309,63 @@ void TravelNodeMap::printNodeStore()
     fflush(stdout);
 }
 
+namespace
+{
+    uint32 const TRAVEL_NODE_STORE_VERSION = 1;
+
+    enum TravelNodeStoreSection : uint32
+    {
+        TRAVEL_NODE_STORE_NODES = 1,
+        TRAVEL_NODE_STORE_LINK_OFFSETS = 2,
+        TRAVEL_NODE_STORE_LINKS = 3,
+        TRAVEL_NODE_STORE_POINTS = 4
+    };
+
+    // one entry of the CSR link array, the links of node i are [offsets[i], offsets[i + 1])
+    struct TravelNodeStoreLink
+    {
+        uint32 target;
+        uint32 pathObject;
+        float distance;
+        float swimDistance;
+        float extraCost;
+        uint32 pointCount;
+        uint8 pathType;
+        uint8 calculated;
+        uint8 maxLevelCreature[3];
+        uint8 quantized;
+        uint8 padding[2];
+    };
+
+    static_assert(sizeof(TravelNodeStoreLink) == 32, "TravelNodeStoreLink is written as is");
+
+    // path points are stored on a 1/16 yard grid as 16 bit steps from the previous point
+    float const TRAVEL_NODE_POINT_SCALE = 16.0f;
+
+    bool QuantizePath(std::vector<WorldPosition>& path, std::vector<int32>& grid)
+    {
+        grid.clear();
+        for (WorldPosition& point : path)
+        {
+            if (point.getMapId() != path.front().getMapId())
+                return false;
+
+            grid.push_back(int32(std::lround(point.getX() * TRAVEL_NODE_POINT_SCALE)));
+            grid.push_back(int32(std::lround(point.getY() * TRAVEL_NODE_POINT_SCALE)));
+            grid.push_back(int32(std::lround(point.getZ() * TRAVEL_NODE_POINT_SCALE)));
+        }
+
+        for (uint32 i = 3; i < grid.size(); ++i)
+        {
+            int32 step = grid[i] - grid[i - 3];
+            if (step < INT16_MIN || step > INT16_MAX)
+                return false;
+        }
+
+        return true;
+    }
+}
+
 void TravelNodeMap::saveNodeStore()
 {
     if (!hasToSave)
@@ -2315,6 +2373,315 @@ void TravelNodeMap::saveNodeStore()
 
     hasToSave = false;
 
+    if (!sPlayerbotAIConfig->travelNodeStoreFile.empty())
+    {
+        if (saveNodeStoreToFile())
+            return;
+
+        LOG_ERROR("playerbots", ">> Could not write the travelNode store file, saving to the database instead.");
+    }
+
+    saveNodeStoreToDb();
+}
+
+void TravelNodeMap::loadNodeStore()
+{
+    if (!sPlayerbotAIConfig->travelNodeStoreFile.empty())
+    {
+        if (loadNodeStoreFromFile())
+            return;
+
+        // the nodes imported from the database are written to the store file on the next save
+        hasToSave = true;
+    }
+
+    loadNodeStoreFromDb();
+}
+
+void TravelNodeMap::importNodeStoreFromDb()
+{
+    removeNodes();
+    loadNodeStoreFromDb();
+
+    // startup loads the store file, without rewriting it the next restart would undo the import
+    if (!sPlayerbotAIConfig->travelNodeStoreFile.empty() && !saveNodeStoreToFile())
+    {
+        LOG_ERROR("playerbots", ">> Could not write the imported travelNodes to the store file.");
+        hasToSave = true;
+    }
+}
+
+bool TravelNodeMap::saveNodeStoreToFile()
+{
+    std::string const path = PlayerbotSnapshotFile::ResolvePath(sPlayerbotAIConfig->travelNodeStoreFile);
+
+    std::vector<TravelNode*> anodes = sTravelNodeMap->getNodes();
+    std::unordered_map<TravelNode*, uint32> saveNodes;
+    for (uint32 i = 0; i < anodes.size(); i++)
+        saveNodes.insert(std::make_pair(anodes[i], i));
+
+    PlayerbotCacheSnapshotWriter writer;
+    writer.BeginSection(TRAVEL_NODE_STORE_NODES);
+    writer.PutUInt32(anodes.size());
+    for (TravelNode* node : anodes)
+    {
+        writer.PutUInt32(node->getMapId());
+        writer.PutFloat(node->getX());
+        writer.PutFloat(node->getY());
+        writer.PutFloat(node->getZ());
+        writer.PutUInt32(node->isLinked());
+        writer.PutString(node->getName());
+    }
+
+    std::vector<uint32> offsets;
+    std::vector<TravelNodeStoreLink> links;
+    std::vector<uint8> points;
+    std::vector<int32> grid;
+    offsets.reserve(anodes.size() + 1);
+
+    for (TravelNode* node : anodes)
+    {
+        offsets.push_back(links.size());
+        for (auto& link : *node->getLinks())
+        {
+            auto target = saveNodes.find(link.first);
+            if (target == saveNodes.end())
+                continue;
+
+            TravelNodePath* nodePath = link.second;
+            std::vector<uint8> maxLevelCreature = nodePath->getMaxLevelCreature();
+            std::vector<WorldPosition> ppath = nodePath->getPath();
+
+            TravelNodeStoreLink entry = {};
+            entry.target = target->second;
+            entry.pathObject = nodePath->getPathObject();
+            entry.distance = nodePath->getDistance();
+            entry.swimDistance = nodePath->getSwimDistance();
+            entry.extraCost = nodePath->getExtraCost();
+            entry.pointCount = ppath.size();
+            entry.pathType = static_cast<uint8>(nodePath->getPathType());
+            entry.calculated = nodePath->getCalculated();
+            for (uint8 i = 0; i < 3 && i < maxLevelCreature.size(); ++i)
+                entry.maxLevelCreature[i] = maxLevelCreature[i];
+
+            if (!ppath.empty())
+            {
+                auto put = [&points](auto value)
+                {
+                    uint8 const* bytes = reinterpret_cast<uint8 const*>(&value);
+                    points.insert(points.end(), bytes, bytes + sizeof(value));
+                };
+
+                entry.quantized = QuantizePath(ppath, grid);
+                if (entry.quantized)
+                {
+                    put(uint32(ppath.front().getMapId()));
+                    put(grid[0]);
+                    put(grid[1]);
+                    put(grid[2]);
+                    for (uint32 i = 3; i < grid.size(); ++i)
+                        put(int16(grid[i] - grid[i - 3]));
+                }
+                else
+                {
+                    for (WorldPosition& point : ppath)
+                    {
+                        put(uint32(point.getMapId()));
+                        put(point.getX());
+                        put(point.getY());
+                        put(point.getZ());
+                    }
+                }
+            }
+
+            links.push_back(entry);
+        }
+    }
+
+    offsets.push_back(links.size());
+
+    writer.BeginSection(TRAVEL_NODE_STORE_LINK_OFFSETS);
+    writer.PutIds(offsets);
+    writer.BeginSection(TRAVEL_NODE_STORE_LINKS);
+    writer.PutUInt32(links.size());
+    if (!links.empty())
+        writer.PutRaw(links.data(), links.size() * sizeof(TravelNodeStoreLink));
+    writer.BeginSection(TRAVEL_NODE_STORE_POINTS);
+    if (!points.empty())
+        writer.PutRaw(points.data(), points.size());
+
+    if (!writer.Save(path, TRAVEL_NODE_STORE_VERSION, 0))
+        return false;
+
+    LOG_INFO("playerbots", ">> Saved {} travelNodes, {} paths, {} bytes of path points to {}.", anodes.size(),
+             links.size(), points.size(), path);
+    return true;
+}
+
+bool TravelNodeMap::loadNodeStoreFromFile()
+{
+    std::string const path = PlayerbotSnapshotFile::ResolvePath(sPlayerbotAIConfig->travelNodeStoreFile);
+
+    PlayerbotSnapshotFile file;
+    SnapshotOpenResult result = file.Open(path, TRAVEL_NODE_STORE_VERSION, 0);
+    if (result != SnapshotOpenResult::Ok)
+    {
+        if (result == SnapshotOpenResult::Missing)
+            LOG_INFO("playerbots", ">> TravelNode store {} not found, loading travelNodes from the database.", path);
+        else
+            LOG_ERROR("playerbots", ">> TravelNode store {} can not be used, loading travelNodes from the database.",
+                      path);
+
+        return false;
+    }
+
+    // decode everything before touching the node map so a damaged file falls back to the database cleanly
+    struct StoredNode
+    {
+        WorldPosition pos;
+        std::string name;
+        bool linked;
+    };
+
+    std::vector<StoredNode> storedNodes;
+    std::vector<uint32> offsets;
+    std::vector<TravelNodeStoreLink> links;
+
+    PlayerbotCacheSnapshotSection nodeSection, offsetSection, linkSection, pointSection;
+    if (!file.GetSection(TRAVEL_NODE_STORE_NODES, nodeSection) ||
+        !file.GetSection(TRAVEL_NODE_STORE_LINK_OFFSETS, offsetSection) ||
+        !file.GetSection(TRAVEL_NODE_STORE_LINKS, linkSection) ||
+        !file.GetSection(TRAVEL_NODE_STORE_POINTS, pointSection))
+    {
+        LOG_ERROR("playerbots", ">> TravelNode store {} is incomplete, loading travelNodes from the database.", path);
+        return false;
+    }
+
+    uint32 nodeCount = nodeSection.GetUInt32();
+    storedNodes.reserve(std::min<uint32>(nodeCount, 1 << 20));
+    for (uint32 i = 0; i < nodeCount && !nodeSection.IsFailed(); ++i)
+    {
+        uint32 mapId = nodeSection.GetUInt32();
+        float x = nodeSection.GetFloat();
+        float y = nodeSection.GetFloat();
+        float z = nodeSection.GetFloat();
+        bool linked = nodeSection.GetUInt32();
+        storedNodes.push_back({WorldPosition(mapId, x, y, z), nodeSection.GetString(), linked});
+    }
+
+    uint32 linkCount = linkSection.GetUInt32();
+    if (!linkSection.IsFailed() && linkCount <= (1 << 24))
+    {
+        links.resize(linkCount);
+        if (linkCount)
+            linkSection.GetRaw(links.data(), linkCount * sizeof(TravelNodeStoreLink));
+    }
+
+    if (nodeSection.IsFailed() || storedNodes.empty() || !offsetSection.GetIds(offsets) || linkSection.IsFailed() ||
+        links.size() != linkCount || offsets.size() != storedNodes.size() + 1 || offsets.back() != links.size())
+    {
+        LOG_ERROR("playerbots", ">> TravelNode store {} is damaged, loading travelNodes from the database.", path);
+        return false;
+    }
+
+    std::vector<std::vector<WorldPosition>> paths(links.size());
+    for (uint32 l = 0; l < links.size() && !pointSection.IsFailed(); ++l)
+    {
+        TravelNodeStoreLink const& link = links[l];
+        if (link.target >= storedNodes.size())
+        {
+            LOG_ERROR("playerbots", ">> TravelNode store {} is damaged, loading travelNodes from the database.", path);
+            return false;
+        }
+
+        if (!link.pointCount)
+            continue;
+
+        std::vector<WorldPosition>& ppath = paths[l];
+        ppath.reserve(std::min<uint32>(link.pointCount, 1 << 16));
+        if (link.quantized)
+        {
+            uint32 mapId = pointSection.GetUInt32();
+            int32 grid[3];
+            pointSection.GetRaw(grid, sizeof(grid));
+            for (uint32 p = 0; p < link.pointCount && !pointSection.IsFailed(); ++p)
+            {
+                if (p)
+                {
+                    for (int32& axis : grid)
+                    {
+                        int16 step;
+                        pointSection.GetRaw(&step, sizeof(step));
+                        axis += step;
+                    }
+                }
+
+                ppath.push_back(WorldPosition(mapId, grid[0] / TRAVEL_NODE_POINT_SCALE,
+                                              grid[1] / TRAVEL_NODE_POINT_SCALE, grid[2] / TRAVEL_NODE_POINT_SCALE));
+            }
+        }
+        else
+        {
+            for (uint32 p = 0; p < link.pointCount && !pointSection.IsFailed(); ++p)
+            {
+                uint32 mapId = pointSection.GetUInt32();
+                float x = pointSection.GetFloat();
+                float y = pointSection.GetFloat();
+                float z = pointSection.GetFloat();
+                ppath.push_back(WorldPosition(mapId, x, y, z));
+            }
+        }
+    }
+
+    if (pointSection.IsFailed())
+    {
+        LOG_ERROR("playerbots", ">> TravelNode store {} is damaged, loading travelNodes from the database.", path);
+        return false;
+    }
+
+    std::vector<TravelNode*> loadedNodes;
+    loadedNodes.reserve(storedNodes.size());
+    for (StoredNode const& stored : storedNodes)
+    {
+        TravelNode* node = addNode(stored.pos, stored.name, true);
+        if (stored.linked)
+            node->setLinked(true);
+        else
+            hasToGen = true;
+
+        loadedNodes.push_back(node);
+    }
+
+    for (uint32 i = 0; i < loadedNodes.size(); ++i)
+    {
+        for (uint32 l = offsets[i]; l < offsets[i + 1] && l < links.size(); ++l)
+        {
+            TravelNodeStoreLink const& link = links[l];
+            TravelNodePath* nodePath = loadedNodes[i]->setPathTo(
+                loadedNodes[link.target],
+                TravelNodePath(link.distance, link.extraCost, link.pathType, link.pathObject, link.calculated,
+                               {link.maxLevelCreature[0], link.maxLevelCreature[1], link.maxLevelCreature[2]},
+                               link.swimDistance),
+                true);
+
+            if (!link.calculated)
+                hasToGen = true;
+
+            if (paths[l].empty())
+                continue;
+
+            nodePath->setPath(paths[l]);
+            if (nodePath->getCalculated())
+                nodePath->setComplete(true);
+        }
+    }
+
+    LOG_INFO("playerbots", ">> Loaded {} travelNodes and {} paths from {}.", loadedNodes.size(), links.size(), path);
+    return true;
+}
+
+void TravelNodeMap::saveNodeStoreToDb()
+{
     PlayerbotsDatabaseTransaction trans = PlayerbotsDatabase.BeginTransaction();
 
     trans->Append(PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_DEL_TRAVELNODE));
@@ -2401,7 +2768,7 @@ void TravelNodeMap::saveNodeStore()
     PlayerbotsDatabase.CommitTransaction(trans);
 }
 
-void TravelNodeMap::loadNodeStore()
+void TravelNodeMap::loadNodeStoreFromDb()
 {
     std::string const query = "SELECT id, name, map_id, x, y, z, linked FROM playerbots_travelnode";
 
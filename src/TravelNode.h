@@ -572,8 +572,16 @@ public:
     void printMap();
 
     void printNodeStore();
+    // binary store file when configured, the playerbots_travelnode tables otherwise
     void saveNodeStore();
     void loadNodeStore();
+    bool saveNodeStoreToFile();
+    bool loadNodeStoreFromFile();
+    // the tables stay the exchange format for tooling
+    void saveNodeStoreToDb();
+    void loadNodeStoreFromDb();
+    // replaces the nodes in memory with the tables and writes them to the store file
+    void importNodeStoreFromDb();
 
     bool cropUselessNode(TravelNode* startNode);
     TravelNode* addZoneLinkNode(TravelNode* startNode);
@@ -13,11 +13,18 @@
  * with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <fstream>
+
 #include "BattleGroundTactics.h"
 #include "Chat.h"
+#include "EngineCapture.h"
 #include "GuildTaskMgr.h"
+#include "ObjectAccessor.h"
 #include "PerformanceMonitor.h"
+#include "PlayerbotAI.h"
+#include "PlayerbotCacheSnapshot.h"
 #include "PlayerbotMgr.h"
+#include "Playerbots.h"
 #include "RandomPlayerbotMgr.h"
 #include "ScriptMgr.h"
 #include "PathfindingBotManager.h"
@@ -43,6 +50,11 @@ public:
             {"clear", HandlePathfindClearCommand, SEC_GAMEMASTER, Console::No},
         };
 
+        static ChatCommandTable playerbotsEngineCommandTable = {
+            {"capture", HandleEngineCaptureCommand, SEC_GAMEMASTER, Console::Yes},
+            {"replay", HandleEngineReplayCommand, SEC_GAMEMASTER, Console::Yes},
+        };
+
         static ChatCommandTable playerbotsAccountCommandTable = {
             {"setKey", HandleSetSecurityKeyCommand, SEC_PLAYER, Console::No},
             {"link", HandleLinkAccountCommand, SEC_PLAYER, Console::No},
@@ -54,10 +66,13 @@ public:
             {"bot", HandlePlayerbotCommand, SEC_PLAYER, Console::No},
             {"gtask", HandleGuildTaskCommand, SEC_GAMEMASTER, Console::Yes},
             {"pmon", HandlePerfMonCommand, SEC_GAMEMASTER, Console::Yes},
+            {"snapshot", HandleCacheSnapshotCommand, SEC_GAMEMASTER, Console::Yes},
+            {"tickscale", HandleTickScaleCommand, SEC_GAMEMASTER, Console::Yes},
             {"rndbot", HandleRandomPlayerbotCommand, SEC_GAMEMASTER, Console::Yes},
             {"debug", playerbotsDebugCommandTable},
             {"account", playerbotsAccountCommandTable},
             {"pathfind", playerbotsPathfindCommandTable},
+            {"engine", playerbotsEngineCommandTable},
         };
 
         static ChatCommandTable commandTable = {
@@ -116,6 +131,83 @@ public:
         return true;
     }
 
+    static bool HandleCacheSnapshotCommand(ChatHandler* handler, char const* args)
+    {
+        if (!sPlayerbotCacheSnapshot->IsEnabled())
+        {
+            handler->PSendSysMessage("Playerbots cache snapshot is disabled");
+            return true;
+        }
+
+        // bots read the caches from the map threads, so they are only rebuilt on the next start
+        if (!strcmp(args, "rebuild"))
+        {
+            if (sPlayerbotCacheSnapshot->Invalidate())
+                handler->PSendSysMessage("Playerbots cache snapshot {} removed, caches are rebuilt on next start",
+                                         sPlayerbotCacheSnapshot->GetPath());
+            else
+                handler->PSendSysMessage("Playerbots cache snapshot {} not found", sPlayerbotCacheSnapshot->GetPath());
+
+            return true;
+        }
+
+        std::ifstream file(sPlayerbotCacheSnapshot->GetPath(), std::ios::binary);
+        handler->PSendSysMessage("Playerbots cache snapshot {}: {}", sPlayerbotCacheSnapshot->GetPath(),
+                                 file ? "present" : "missing");
+        return true;
+    }
+
+    static bool HandleTickScaleCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        for (std::string const& line : sRandomPlayerbotMgr->GetTickScaleReport())
+            handler->PSendSysMessage("{}", line);
+
+        return true;
+    }
+
+    static bool HandleEngineCaptureCommand(ChatHandler* handler, char const* args)
+    {
+        std::vector<std::string> params = split(args, ' ');
+        if (params.empty())
+        {
+            handler->PSendSysMessage("usage: .playerbots engine capture <bot name> [ticks]");
+            return true;
+        }
+
+        Player* bot = ObjectAccessor::FindPlayerByName(params[0]);
+        PlayerbotAI* botAI = GET_PLAYERBOT_AI(bot);
+        if (!botAI)
+        {
+            handler->PSendSysMessage("{} is not an online bot", params[0]);
+            return true;
+        }
+
+        uint32 ticks = params.size() > 1 ? std::max(1, atoi(params[1].c_str())) : 100;
+        // the engines belong to the bot's map thread
+        botAI->AddTimedEvent([botAI, ticks]() { botAI->StartEngineCapture(ticks); }, 0);
+        handler->PSendSysMessage("Capturing {} ticks of {} to {}", ticks, params[0],
+                                 sPlayerbotAIConfig->engineCaptureFile);
+        return true;
+    }
+
+    static bool HandleEngineReplayCommand(ChatHandler* handler, char const* args)
+    {
+        uint32 repeat = *args ? std::max(1, atoi(args)) : 10;
+
+        std::vector<EngineCaptureTick> ticks;
+        if (!EngineCapture::Load(sPlayerbotAIConfig->engineCaptureFile, ticks) || ticks.empty())
+        {
+            handler->PSendSysMessage("No engine capture in {}", sPlayerbotAIConfig->engineCaptureFile);
+            return true;
+        }
+
+        uint32 tickCount = ticks.size();
+        uint32 scheduled = EngineCapture::ScheduleReplay(ticks, repeat);
+        handler->PSendSysMessage("Replaying {} ticks in {} strategy sets {} times, results go to the playerbots log",
+                                 tickCount, scheduled, repeat);
+        return true;
+    }
+
     static bool HandleDebugBGCommand(ChatHandler* handler, char const* args)
     {
         return BGTactics::HandleConsoleCommand(handler, args);
@@ -5,7 +5,12 @@
 
 #include "Engine.h"
 
+#include <chrono>
+#include <mutex>
+#include <typeinfo>
+
 #include "Action.h"
+#include "EngineCapture.h"
 #include "Event.h"
 #include "PerformanceMonitor.h"
 #include "Playerbots.h"
@@ -13,6 +18,89 @@
 #include "Strategy.h"
 #include "Timer.h"
 
+namespace
+{
+std::mutex engineTemplatesLock;
+std::unordered_map<std::string, std::weak_ptr<EngineTemplate const>> engineTemplates;
+}  // namespace
+
+std::shared_ptr<EngineTemplate const> EngineTemplate::Get(std::map<std::string, Strategy*> const& strategies)
+{
+    // the same strategy name can resolve to different classes depending on the bot class context
+    std::string signature;
+    for (auto const& i : strategies)
+    {
+        signature += i.first;
+        signature += '@';
+        signature += typeid(*i.second).name();
+        signature += ',';
+    }
+
+    std::lock_guard<std::mutex> guard(engineTemplatesLock);
+
+    std::weak_ptr<EngineTemplate const>& cached = engineTemplates[signature];
+    if (std::shared_ptr<EngineTemplate const> engineTemplate = cached.lock())
+        return engineTemplate;
+
+    std::shared_ptr<EngineTemplate> engineTemplate = std::make_shared<EngineTemplate>();
+    for (auto const& i : strategies)
+    {
+        Strategy* strategy = i.second;
+        engineTemplate->strategyTypeMask |= strategy->GetType();
+        for (auto const& iter : strategy->actionNodeFactories.creators)
+            engineTemplate->actionNodeCreators[iter.first] = iter.second;
+    }
+
+    // drop templates no engine uses anymore
+    for (auto i = engineTemplates.begin(); i != engineTemplates.end();)
+    {
+        if (i->second.expired() && i->first != signature)
+            i = engineTemplates.erase(i);
+        else
+            ++i;
+    }
+
+    cached = engineTemplate;
+    return engineTemplate;
+}
+
+uint32 EngineTemplate::GetCachedCount()
+{
+    std::lock_guard<std::mutex> guard(engineTemplatesLock);
+
+    // expired templates are only pruned on the next miss, count the ones engines still use
+    uint32 count = 0;
+    for (auto const& i : engineTemplates)
+    {
+        if (!i.second.expired())
+            ++count;
+    }
+
+    return count;
+}
+
+ActionNode* EngineTemplate::CreateActionNode(std::string name, PlayerbotAI* botAI) const
+{
+    size_t found = name.find("::");
+    std::string qualifier;
+    if (found != std::string::npos)
+    {
+        qualifier = name.substr(found + 2);
+        name = name.substr(0, found);
+    }
+
+    auto creator = actionNodeCreators.find(name);
+    if (creator == actionNodeCreators.end())
+        return nullptr;
+
+    ActionNode* node = creator->second(botAI);
+    Qualified* q = dynamic_cast<Qualified*>(node);
+    if (q && found != std::string::npos)
+        q->Qualify(qualifier);
+
+    return node;
+}
+
 Engine::Engine(PlayerbotAI* botAI, AiObjectContext* factory) : PlayerbotAIAware(botAI), aiObjectContext(factory)
 {
     lastRelevance = 0.0f;
@@ -97,39 +185,33 @@ void Engine::Reset()
         delete action;
     }
 
-    for (TriggerNode* trigger : triggers)
-    {
-        delete trigger;
-    }
-
+    // trigger nodes and multipliers are owned by the strategies' StrategyNodes
     triggers.clear();
-
-    for (Multiplier* multiplier : multipliers)
-    {
-        delete multiplier;
-    }
-
     multipliers.clear();
-
-    actionNodeFactories.creators.clear();
+    strategyNodes.clear();
+    engineTemplate.reset();
 }
 
 void Engine::Init()
 {
+    PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(PERF_MON_TOTAL, "Engine::Init");
+
     Reset();
 
     for (std::map<std::string, Strategy*>::iterator i = strategies.begin(); i != strategies.end(); i++)
     {
-        Strategy* strategy = i->second;
-        strategyTypeMask |= strategy->GetType();
-        strategy->InitMultipliers(multipliers);
-        strategy->InitTriggers(triggers);
-        for (auto &iter : strategy->actionNodeFactories.creators)
-        {
-            actionNodeFactories.creators[iter.first] = iter.second;
-        }
+        std::shared_ptr<StrategyNodes> nodes = i->second->GetNodes();
+        multipliers.insert(multipliers.end(), nodes->multipliers.begin(), nodes->multipliers.end());
+        triggers.insert(triggers.end(), nodes->triggers.begin(), nodes->triggers.end());
+        strategyNodes.push_back(std::move(nodes));
     }
 
+    engineTemplate = EngineTemplate::Get(strategies);
+    strategyTypeMask = engineTemplate->strategyTypeMask;
+
+    if (pmo)
+        pmo->finish();
+
     if (testMode)
     {
         FILE* file = fopen("test.log", "w");
@@ -138,13 +220,25 @@ void Engine::Init()
     }
 }
 
+namespace
+{
+    uint32 MicrosSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
 bool Engine::DoNextAction(Unit* unit, uint32 depth, bool minimal)
 {
     LogAction("--- AI Tick ---");
 
-    if (sPlayerbotAIConfig->logValuesPerTick)
+    if (sPlayerbotAIConfig->logValuesPerTick && !replay)
         LogValues();
 
+    auto const tickStart = std::chrono::steady_clock::now();
+    if (captureTicks && !capture)
+        capture = std::make_unique<EngineCaptureTick>();
+
     bool actionExecuted = false;
     ActionBasket* basket = nullptr;
     time_t currentTime = time(nullptr);
@@ -154,7 +248,11 @@ bool Engine::DoNextAction(Unit* unit, uint32 depth, bool minimal)
     PushDefaultActions();
 
     uint32 iterations = 0;
-    uint32 iterationsPerTick = queue.Size() * (minimal ? 2 : sPlayerbotAIConfig->iterationsPerTick);
+    // a replay measures the engine itself, so it keeps the configured iterations whatever the server load
+    uint32 iterationsPerAction = minimal ? 2
+                                 : replay  ? sPlayerbotAIConfig->iterationsPerTick
+                                           : PlayerbotAI::GetIterationsPerTick(botAI->GetTickScale());
+    uint32 iterationsPerTick = queue.Size() * iterationsPerAction;
 
     while (++iterations <= iterationsPerTick)
     {
@@ -172,26 +270,27 @@ bool Engine::DoNextAction(Unit* unit, uint32 depth, bool minimal)
         ActionNode* actionNode = queue.Pop();  // NOTE: Pop() deletes basket
         Action* action = InitializeAction(actionNode);
 
+        auto const stepStart = std::chrono::steady_clock::now();
+        EngineCaptureAction* step = nullptr;
+        if (capture && action)
+        {
+            step = &capture->actions.emplace_back();
+            step->name = action->getName();
+        }
+
+        if (replay)
+            replayed = action ? replay->TakeAction(action->getName()) : nullptr;
+
         if (!action)
         {
             LogAction("A:%s - UNKNOWN", actionNode->getName().c_str());
         }
-        else if (action->isUseful())
+        else if (IsUseful(action, step))
         {
             // Apply multipliers early to avoid unnecessary iterations
-            for (Multiplier* multiplier : multipliers)
-            {
-                relevance *= multiplier->GetValue(action);
-                action->setRelevance(relevance);
-
-                if (relevance <= 0)
-                {
-                    LogAction("Multiplier %s made action %s useless", multiplier->getName().c_str(), action->getName().c_str());
-                    break;
-                }
-            }
+            relevance = ApplyMultipliers(action, relevance, step);
 
-            if (action->isPossible() && relevance > 0)
+            if (IsPossible(action, step) && relevance > 0)
             {
                 if (!skipPrerequisites)
                 {
@@ -199,15 +298,17 @@ bool Engine::DoNextAction(Unit* unit, uint32 depth, bool minimal)
 
                     if (MultiplyAndPush(actionNode->getPrerequisites(), relevance + 0.002f, false, event, "prereq"))
                     {
+                        if (step)
+                            step->micros = MicrosSince(stepStart);
+
                         PushAgain(actionNode, relevance + 0.001f, event);
                         continue;
                     }
                 }
 
-                PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(PERF_MON_ACTION, action->getName(), &aiObjectContext->performanceStack);
-                actionExecuted = ListenAndExecute(action, event);
-                if (pmo)
-                    pmo->finish();
+                actionExecuted = Execute(action, event, step);
+                if (step)
+                    step->micros = MicrosSince(stepStart);
 
                 if (actionExecuted)
                 {
@@ -235,6 +336,9 @@ bool Engine::DoNextAction(Unit* unit, uint32 depth, bool minimal)
             lastRelevance = relevance;
         }
 
+        if (step && !step->micros)
+            step->micros = MicrosSince(stepStart);
+
         delete actionNode;  // Always delete after processing the action node
     }
 
@@ -248,12 +352,128 @@ bool Engine::DoNextAction(Unit* unit, uint32 depth, bool minimal)
 
     queue.RemoveExpired();
 
+    if (capture)
+        FinishCapture(MicrosSince(tickStart), minimal);
+
     return actionExecuted;
 }
 
+bool Engine::IsUseful(Action* action, EngineCaptureAction* step)
+{
+    if (replay)
+    {
+        return replayed && replayed->useful;
+    }
+
+    bool useful = action->isUseful();
+    if (step)
+        step->useful = useful;
+
+    return useful;
+}
+
+float Engine::ApplyMultipliers(Action* action, float relevance, EngineCaptureAction* step)
+{
+    if (replay)
+    {
+        relevance *= replayed ? replayed->multiplier : 1.0f;
+        action->setRelevance(relevance);
+        return relevance;
+    }
+
+    float total = 1.0f;
+    for (Multiplier* multiplier : multipliers)
+    {
+        float value = multiplier->GetValue(action);
+        total *= value;
+        relevance *= value;
+        action->setRelevance(relevance);
+
+        if (relevance <= 0)
+        {
+            LogAction("Multiplier %s made action %s useless", multiplier->getName().c_str(), action->getName().c_str());
+            break;
+        }
+    }
+
+    if (step)
+        step->multiplier = total;
+
+    return relevance;
+}
+
+bool Engine::IsPossible(Action* action, EngineCaptureAction* step)
+{
+    if (replay)
+    {
+        return replayed && replayed->possible;
+    }
+
+    bool possible = action->isPossible();
+    if (step)
+        step->possible = possible;
+
+    return possible;
+}
+
+bool Engine::Execute(Action* action, Event event, EngineCaptureAction* step)
+{
+    if (replay)
+    {
+        return replayed && replayed->executed;
+    }
+
+    PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(PERF_MON_ACTION, action->getName(), &aiObjectContext->performanceStack);
+    bool executed = ListenAndExecute(action, event);
+    if (pmo)
+        pmo->finish();
+
+    if (step)
+        step->executed = executed;
+
+    return executed;
+}
+
+void Engine::StartCapture(uint32 ticks)
+{
+    captureTicks = ticks;
+    capture.reset();
+}
+
+void Engine::FinishCapture(uint32 micros, bool minimal)
+{
+    Player* bot = botAI->GetBot();
+    capture->bot = bot->GetGUID().GetCounter();
+    capture->botClass = bot->getClass();
+    capture->minimal = minimal;
+    capture->micros = micros;
+    for (auto const& i : strategies)
+    {
+        if (!capture->strategies.empty())
+            capture->strategies += ',';
+
+        capture->strategies += i.first;
+    }
+
+    EngineCapture::Write(*capture);
+    capture.reset();
+    --captureTicks;
+}
+
+bool Engine::ReplayTick(EngineReplay& tickReplay)
+{
+    tickReplay.Rewind();
+    replay = &tickReplay;
+    bool executed = DoNextAction(nullptr, 0, tickReplay.IsMinimal());
+    replay = nullptr;
+    replayed = nullptr;
+    return executed;
+}
+
 ActionNode* Engine::CreateActionNode(std::string const name)
 {
-    ActionNode* node = actionNodeFactories.GetContextObject(name, botAI);
+    ++allocations;
+    ActionNode* node = engineTemplate ? engineTemplate->CreateActionNode(name, botAI) : nullptr;
     if (node)
         return node;
 
@@ -269,10 +489,12 @@ bool Engine::MultiplyAndPush(NextAction** actions, float forceRelevance, bool sk
     bool pushed = false;
     if (actions)
     {
+        ++allocations;
         for (uint32 j = 0; actions[j]; j++)
         {
             if (NextAction* nextAction = actions[j])
             {
+                ++allocations;
                 ActionNode* action = CreateActionNode(nextAction->getName());
                 InitializeAction(action);
 
@@ -286,6 +508,7 @@ bool Engine::MultiplyAndPush(NextAction** actions, float forceRelevance, bool sk
                 {
                     LogAction("PUSH:%s - %f (%s)", action->getName().c_str(), k, pushType);
                     queue.Push(new ActionBasket(action, k, skipPrerequisites, event));
+                    ++allocations;
                     pushed = true;
                 }
                 else
@@ -419,6 +642,10 @@ bool Engine::removeStrategy(std::string const name, bool init)
 
 void Engine::removeAllStrategies()
 {
+    // full resets rebuild the strategies' nodes, InitTriggers may depend on the bot's current spells and spec
+    for (std::map<std::string, Strategy*>::iterator i = strategies.begin(); i != strategies.end(); i++)
+        i->second->InvalidateNodes();
+
     strategies.clear();
     Init();
 }
@@ -454,17 +681,39 @@ void Engine::ProcessTriggers(bool minimal)
         if (fires.find(trigger) != fires.end())
             continue;
 
+        if (replay)
+        {
+            // the capture only holds the triggers that were due, the others replay as not firing
+            Event event = replay->GetTriggerEvent(trigger->getName());
+            if (!event)
+                continue;
+
+            fires[trigger] = event;
+            LogAction("T:%s", trigger->getName().c_str());
+            continue;
+        }
+
         if (testMode || trigger->needCheck(now))
         {
             if (minimal && node->getFirstRelevance() < 100)
                 continue;
 
+            auto const checkStart = std::chrono::steady_clock::now();
             PerformanceMonitorOperation* pmo =
                 sPerformanceMonitor->start(PERF_MON_TRIGGER, trigger->getName(), &aiObjectContext->performanceStack);
             Event event = trigger->Check();
             if (pmo)
                 pmo->finish();
 
+            if (capture)
+            {
+                EngineCaptureTrigger& checked = capture->triggers.emplace_back();
+                checked.name = trigger->getName();
+                checked.param = event.getParam();
+                checked.micros = MicrosSince(checkStart);
+                checked.fired = !!event;
+            }
+
             if (!event)
                 continue;
 
@@ -7,6 +7,8 @@
 #define _PLAYERBOT_ENGINE_H
 
 #include <map>
+#include <memory>
+#include <unordered_map>
 
 #include "Multiplier.h"
 #include "PlayerbotAIAware.h"
@@ -17,9 +19,12 @@
 class Action;
 class ActionNode;
 class AiObjectContext;
+class EngineReplay;
 class Event;
 class NextAction;
 class PlayerbotAI;
+struct EngineCaptureAction;
+struct EngineCaptureTick;
 
 enum ActionResult
 {
@@ -59,6 +64,22 @@ private:
     std::list<ActionExecutionListener*> listeners;
 };
 
+// Bot independent part of an engine: the merged action node factories of a strategy set.
+// Immutable once built and shared by every engine running the same strategies.
+class EngineTemplate
+{
+public:
+    typedef NamedObjectFactoryList<ActionNode>::ObjectCreator ActionNodeCreator;
+
+    static std::shared_ptr<EngineTemplate const> Get(std::map<std::string, Strategy*> const& strategies);
+    static uint32 GetCachedCount();
+
+    ActionNode* CreateActionNode(std::string name, PlayerbotAI* botAI) const;
+
+    std::unordered_map<std::string, ActionNodeCreator> actionNodeCreators;
+    uint32 strategyTypeMask = 0;
+};
+
 class Engine : public PlayerbotAIAware
 {
 public:
@@ -87,6 +108,13 @@ public:
     bool HasStrategyType(StrategyType type) { return strategyTypeMask & type; }
     virtual ~Engine(void);
 
+    // the next ticks are appended to the engine capture file
+    void StartCapture(uint32 ticks);
+    // one decision loop on recorded trigger and action results, nothing is checked or executed
+    bool ReplayTick(EngineReplay& tickReplay);
+    // action nodes, baskets and next actions the engine allocated so far
+    uint64 GetAllocations() const { return allocations; }
+
     bool testMode;
 
 private:
@@ -103,6 +131,12 @@ private:
     void LogAction(char const* format, ...);
     void LogValues();
 
+    bool IsUseful(Action* action, EngineCaptureAction* step);
+    float ApplyMultipliers(Action* action, float relevance, EngineCaptureAction* step);
+    bool IsPossible(Action* action, EngineCaptureAction* step);
+    bool Execute(Action* action, Event event, EngineCaptureAction* step);
+    void FinishCapture(uint32 micros, bool minimal);
+
     ActionExecutionListeners actionExecutionListeners;
 
 protected:
@@ -114,7 +148,15 @@ protected:
     float lastRelevance;
     std::string lastAction;
     uint32 strategyTypeMask;
-    NamedObjectFactoryList<ActionNode> actionNodeFactories;
+    std::shared_ptr<EngineTemplate const> engineTemplate;
+    std::vector<std::shared_ptr<StrategyNodes>> strategyNodes;
+
+    uint32 captureTicks = 0;
+    std::unique_ptr<EngineCaptureTick> capture;
+    EngineReplay* replay = nullptr;
+    // recorded outcome of the action taken from the queue while replaying
+    EngineCaptureAction const* replayed = nullptr;
+    uint64 allocations = 0;
 };
 
 #endif
@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "EngineCapture.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#include "Engine.h"
+#include "Playerbots.h"
+#include "RandomPlayerbotMgr.h"
+
+namespace
+{
+    std::mutex captureLock;
+    std::ofstream captureFile;
+}
+
+EngineReplay::EngineReplay(EngineCaptureTick const& tick) : tick(tick)
+{
+    for (EngineCaptureTrigger const& trigger : tick.triggers)
+    {
+        if (trigger.fired)
+            fired.emplace(trigger.name, &trigger);
+    }
+
+    for (EngineCaptureAction const& action : tick.actions)
+        actions[action.name].outcomes.push_back(&action);
+}
+
+Event EngineReplay::GetTriggerEvent(std::string const& name) const
+{
+    auto i = fired.find(name);
+    if (i == fired.end())
+        return Event();
+
+    return Event(name, i->second->param);
+}
+
+EngineCaptureAction const* EngineReplay::TakeAction(std::string const& name)
+{
+    auto i = actions.find(name);
+    if (i == actions.end())
+        return nullptr;
+
+    RecordedOutcomes& recorded = i->second;
+    return recorded.next < recorded.outcomes.size() ? recorded.outcomes[recorded.next++] : nullptr;
+}
+
+void EngineReplay::Rewind()
+{
+    for (auto& [name, recorded] : actions)
+        recorded.next = 0;
+}
+
+// Line format, names come last as they may contain spaces:
+//   tick <bot> <class> <minimal> <micros> <strategies>
+//   t <fired> <micros> <name>\t<param>
+//   a <useful> <possible> <executed> <multiplier> <micros> <name>
+void EngineCapture::Write(EngineCaptureTick const& tick)
+{
+    std::ostringstream out;
+    out << "tick " << tick.bot << " " << uint32(tick.botClass) << " " << tick.minimal << " " << tick.micros << " "
+        << tick.strategies << "\n";
+
+    for (EngineCaptureTrigger const& trigger : tick.triggers)
+        out << "t " << trigger.fired << " " << trigger.micros << " " << trigger.name << "\t" << trigger.param << "\n";
+
+    for (EngineCaptureAction const& action : tick.actions)
+        out << "a " << action.useful << " " << action.possible << " " << action.executed << " " << action.multiplier
+            << " " << action.micros << " " << action.name << "\n";
+
+    std::lock_guard<std::mutex> guard(captureLock);
+    if (!captureFile.is_open())
+        captureFile.open(sPlayerbotAIConfig->engineCaptureFile, std::ios::app);
+
+    captureFile << out.str();
+    captureFile.flush();
+}
+
+bool EngineCapture::Load(std::string const& path, std::vector<EngineCaptureTick>& ticks)
+{
+    std::ifstream in(path);
+    if (!in)
+        return false;
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::istringstream fields(line);
+        std::string type;
+        fields >> type;
+
+        if (type == "tick")
+        {
+            EngineCaptureTick tick;
+            uint32 botClass = 0;
+            fields >> tick.bot >> botClass >> tick.minimal >> tick.micros;
+            tick.botClass = botClass;
+            fields >> std::ws;
+            std::getline(fields, tick.strategies);
+            ticks.push_back(std::move(tick));
+        }
+        else if (type == "t" && !ticks.empty())
+        {
+            EngineCaptureTrigger trigger;
+            fields >> trigger.fired >> trigger.micros >> std::ws;
+            std::getline(fields, trigger.name, '\t');
+            std::getline(fields, trigger.param);
+            ticks.back().triggers.push_back(std::move(trigger));
+        }
+        else if (type == "a" && !ticks.empty())
+        {
+            EngineCaptureAction action;
+            fields >> action.useful >> action.possible >> action.executed >> action.multiplier >> action.micros >>
+                std::ws;
+            std::getline(fields, action.name);
+            ticks.back().actions.push_back(std::move(action));
+        }
+    }
+
+    return true;
+}
+
+uint32 EngineCapture::ScheduleReplay(std::vector<EngineCaptureTick>& ticks, uint32 repeat)
+{
+    // every strategy set replays on its own engine
+    std::map<std::pair<uint8, std::string>, std::shared_ptr<std::vector<EngineCaptureTick>>> groups;
+    for (EngineCaptureTick& tick : ticks)
+    {
+        std::shared_ptr<std::vector<EngineCaptureTick>>& group = groups[{tick.botClass, tick.strategies}];
+        if (!group)
+            group = std::make_shared<std::vector<EngineCaptureTick>>();
+
+        group->push_back(std::move(tick));
+    }
+
+    uint32 scheduled = 0;
+    PlayerBotMap bots = sRandomPlayerbotMgr->GetAllBots();
+    for (auto const& [key, group] : groups)
+    {
+        for (auto const& [guid, bot] : bots)
+        {
+            PlayerbotAI* botAI = GET_PLAYERBOT_AI(bot);
+            if (!botAI || bot->getClass() != key.first)
+                continue;
+
+            // the replay uses the host's strategy objects, so it has to run in the host's own update
+            botAI->AddTimedEvent([botAI, group, repeat]() { EngineCapture::Replay(botAI, *group, repeat); }, 0);
+            ++scheduled;
+            break;
+        }
+    }
+
+    return scheduled;
+}
+
+void EngineCapture::Replay(PlayerbotAI* botAI, std::vector<EngineCaptureTick> const& ticks, uint32 repeat)
+{
+    if (ticks.empty())
+        return;
+
+    Engine engine(botAI, botAI->GetAiObjectContext());
+    for (std::string const& strategy : split(ticks.front().strategies, ','))
+        engine.addStrategy(strategy, false);
+
+    engine.Init();
+
+    std::vector<EngineReplay> replays;
+    replays.reserve(ticks.size());
+    for (EngineCaptureTick const& tick : ticks)
+        replays.emplace_back(tick);
+
+    uint64 const allocationsBefore = engine.GetAllocations();
+    auto const start = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < repeat; ++i)
+    {
+        for (EngineReplay& replay : replays)
+            engine.ReplayTick(replay);
+    }
+
+    double const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64 const replayed = uint64(ticks.size()) * repeat;
+
+    LOG_INFO("playerbots", "Engine replay class {} [{}]: {} ticks in {:.1f} ms, {:.0f} ticks/s, {:.1f} engine allocations/tick",
+             ticks.front().botClass, ticks.front().strategies, replayed, elapsed * 1000.0,
+             elapsed > 0.0 ? replayed / elapsed : 0.0, double(engine.GetAllocations() - allocationsBefore) / replayed);
+
+    // where the captured live ticks spent their time, triggers and actions together
+    std::unordered_map<std::string, uint64> costs;
+    uint64 liveMicros = 0;
+    for (EngineCaptureTick const& tick : ticks)
+    {
+        liveMicros += tick.micros;
+        for (EngineCaptureTrigger const& trigger : tick.triggers)
+            costs["T:" + trigger.name] += trigger.micros;
+
+        for (EngineCaptureAction const& action : tick.actions)
+            costs["A:" + action.name] += action.micros;
+    }
+
+    std::vector<std::pair<std::string, uint64>> top(costs.begin(), costs.end());
+    uint32 const topCount = std::min<uint32>(top.size(), 10);
+    std::partial_sort(top.begin(), top.begin() + topCount, top.end(),
+                      [](auto const& lhs, auto const& rhs) { return lhs.second > rhs.second; });
+
+    LOG_INFO("playerbots", "  captured: {:.1f} us/tick", double(liveMicros) / ticks.size());
+    for (uint32 i = 0; i < topCount; ++i)
+        LOG_INFO("playerbots", "  {:>8.1f} us/tick {}", double(top[i].second) / ticks.size(), top[i].first);
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_ENGINECAPTURE_H
+#define _PLAYERBOT_ENGINECAPTURE_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Common.h"
+#include "Event.h"
+
+class PlayerbotAI;
+
+struct EngineCaptureTrigger
+{
+    std::string name;
+    std::string param;
+    uint32 micros = 0;
+    bool fired = false;
+};
+
+// one action taken from the queue, the same action can be taken several times per tick
+struct EngineCaptureAction
+{
+    std::string name;
+    float multiplier = 1.0f;
+    uint32 micros = 0;
+    bool useful = false;
+    bool possible = false;
+    bool executed = false;
+};
+
+struct EngineCaptureTick
+{
+    uint64 bot = 0;
+    uint8 botClass = 0;
+    bool minimal = false;
+    uint32 micros = 0;
+    // comma separated, in engine order
+    std::string strategies;
+    std::vector<EngineCaptureTrigger> triggers;
+    std::vector<EngineCaptureAction> actions;
+};
+
+// Recorded trigger and action results of one tick, looked up by name while the engine replays it
+class EngineReplay
+{
+public:
+    EngineReplay(EngineCaptureTick const& tick);
+
+    bool IsMinimal() const { return tick.minimal; }
+    Event GetTriggerEvent(std::string const& name) const;
+    // the outcomes of an action in the order the captured tick took it, each take gets the next one. Unknown or used
+    // up actions were not taken that often in the captured tick, they replay as useless
+    EngineCaptureAction const* TakeAction(std::string const& name);
+    // every replayed tick takes the outcomes from the first one again
+    void Rewind();
+
+private:
+    struct RecordedOutcomes
+    {
+        std::vector<EngineCaptureAction const*> outcomes;
+        uint32 next = 0;
+    };
+
+    EngineCaptureTick const& tick;
+    std::unordered_map<std::string, EngineCaptureTrigger const*> fired;
+    std::unordered_map<std::string, RecordedOutcomes> actions;
+};
+
+/**
+ * @brief Offline measurement of the decision loop
+ *
+ * Engines in capture mode append the trigger results, action outcomes and timings of each tick to
+ * AiPlayerbot.EngineCaptureFile. A replay feeds those ticks back through the trigger, queue and multiplier code of a
+ * fresh engine with the same strategies, without checking triggers or executing actions, so the engine overhead can be
+ * compared between builds while the captured timings show where a live tick spends its time.
+ */
+class EngineCapture
+{
+public:
+    static void Write(EngineCaptureTick const& tick);
+    static bool Load(std::string const& path, std::vector<EngineCaptureTick>& ticks);
+
+    // replays every strategy set of the capture on an online bot of the same class
+    static uint32 ScheduleReplay(std::vector<EngineCaptureTick>& ticks, uint32 repeat);
+    static void Replay(PlayerbotAI* botAI, std::vector<EngineCaptureTick> const& ticks, uint32 repeat);
+};
+
+#endif
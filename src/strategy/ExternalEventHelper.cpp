@@ -39,20 +39,19 @@ bool ExternalEventHelper::ParseChatCommand(std::string const command, Player* ow
     return true;
 }
 
-void ExternalEventHelper::HandlePacket(std::map<uint16, std::string>& handlers, WorldPacket const& packet,
+void ExternalEventHelper::HandlePacket(std::map<uint16, std::string> const& handlers, WorldPacket& packet,
                                        Player* owner)
 {
-    uint16 opcode = packet.GetOpcode();
-    std::string const name = handlers[opcode];
-    if (name.empty())
+    auto itr = handlers.find(packet.GetOpcode());
+    if (itr == handlers.end() || itr->second.empty())
         return;
 
-    Trigger* trigger = aiObjectContext->GetTrigger(name);
+    Trigger* trigger = aiObjectContext->GetTrigger(itr->second);
     if (!trigger)
         return;
 
-    WorldPacket p(packet);
-    trigger->ExternalEvent(p, owner);
+    packet.rpos(0);
+    trigger->ExternalEvent(packet, owner);
 }
 
 bool ExternalEventHelper::HandleCommand(std::string const name, std::string const param, Player* owner)
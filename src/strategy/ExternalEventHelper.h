@@ -20,7 +20,7 @@ public:
     ExternalEventHelper(AiObjectContext* aiObjectContext) : aiObjectContext(aiObjectContext) {}
 
     bool ParseChatCommand(std::string const command, Player* owner = nullptr);
-    void HandlePacket(std::map<uint16, std::string>& handlers, WorldPacket const& packet, Player* owner = nullptr);
+    void HandlePacket(std::map<uint16, std::string> const& handlers, WorldPacket& packet, Player* owner = nullptr);
     bool HandleCommand(std::string const name, std::string const param, Player* owner = nullptr);
 
 private:
@@ -121,3 +121,24 @@ Strategy::Strategy(PlayerbotAI* botAI) : PlayerbotAIAware(botAI)
 }
 
 ActionNode* Strategy::GetAction(std::string const name) { return actionNodeFactories.GetContextObject(name, botAI); }
+
+StrategyNodes::~StrategyNodes()
+{
+    for (TriggerNode* trigger : triggers)
+        delete trigger;
+
+    for (Multiplier* multiplier : multipliers)
+        delete multiplier;
+}
+
+std::shared_ptr<StrategyNodes> Strategy::GetNodes()
+{
+    if (!nodes)
+    {
+        nodes = std::make_shared<StrategyNodes>();
+        InitMultipliers(nodes->multipliers);
+        InitTriggers(nodes->triggers);
+    }
+
+    return nodes;
+}
@@ -6,6 +6,8 @@
 #ifndef _PLAYERBOT_STRATEGY_H
 #define _PLAYERBOT_STRATEGY_H
 
+#include <memory>
+
 #include "Action.h"
 #include "Multiplier.h"
 #include "NamedObjectContext.h"
@@ -54,12 +56,26 @@ static float ACTION_MEDIUM_HEAL = 20.0f;
 static float ACTION_CRITICAL_HEAL = 30.0f;
 static float ACTION_EMERGENCY = 90.0f;
 
+// Trigger nodes and multipliers built by one strategy, kept alive by every engine using them
+class StrategyNodes
+{
+public:
+    ~StrategyNodes();
+
+    std::vector<TriggerNode*> triggers;
+    std::vector<Multiplier*> multipliers;
+};
+
 class Strategy : public PlayerbotAIAware
 {
 public:
     Strategy(PlayerbotAI* botAI);
     virtual ~Strategy() {}
 
+    // InitTriggers/InitMultipliers output, built once and reused until InvalidateNodes()
+    std::shared_ptr<StrategyNodes> GetNodes();
+    void InvalidateNodes() { nodes.reset(); }
+
     virtual NextAction** getDefaultActions() { return nullptr; }
     virtual void InitTriggers([[maybe_unused]] std::vector<TriggerNode*>& triggers) {}
     virtual void InitMultipliers([[maybe_unused]] std::vector<Multiplier*>& multipliers) {}
@@ -71,6 +87,9 @@ public:
 
 public:
     NamedObjectFactoryList<ActionNode> actionNodeFactories;
+
+private:
+    std::shared_ptr<StrategyNodes> nodes;
 };
 
 #endif
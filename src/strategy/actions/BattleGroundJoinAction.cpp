@@ -15,6 +15,29 @@
 #include "PositionValue.h"
 #include "UpdateTime.h"
 
+// Adds count bots to a demand counter unless the queue already holds cap bots and players. Other bots decide on the
+// same counters from their own map threads, so the check and the increment are one step.
+static bool ReserveQueueSlots(std::atomic<uint32>& botCount, uint32 playerCount, uint32 count, uint32 cap)
+{
+    uint32 current = botCount.load();
+    do
+    {
+        if (current + playerCount >= cap)
+            return false;
+    } while (!botCount.compare_exchange_weak(current, current + count));
+
+    return true;
+}
+
+// CheckBgQueue may have published a lower count since the reservation, never wrap below zero
+static void ReleaseQueueSlots(std::atomic<uint32>& botCount, uint32 count)
+{
+    uint32 current = botCount.load();
+    while (!botCount.compare_exchange_weak(current, current > count ? current - count : 0))
+    {
+    }
+}
+
 bool BGJoinAction::Execute(Event event)
 {
     uint32 queueType = AI_VALUE(uint32, "bg type");
@@ -57,7 +80,7 @@ bool BGJoinAction::Execute(Event event)
         // set bg type and bm guid
         // botAI->GetAiObjectContext()->GetValue<ObjectGuid>("bg master")->Set(bmGUID);
         botAI->GetAiObjectContext()->GetValue<uint32>("bg type")->Set(queueTypeId);
-        queueType = queueTypeId;
+        return JoinQueue(queueTypeId, true);
     }
 
     return JoinQueue(queueType);
@@ -263,9 +286,9 @@ bool BGJoinAction::shouldJoinBg(BattlegroundQueueTypeId queueTypeId, Battlegroun
 
         if (isRated)
         {
+            // the slots are reserved by JoinQueue once the bot picked this queue
             if (sArenaTeamMgr->GetArenaTeamByCaptain(bot->GetGUID(), type))
             {
-                sRandomPlayerbotMgr->BattlegroundData[queueTypeId][bracketId].ratedArenaBotCount += TeamSize;
                 ratedList.push_back(queueTypeId);
                 return true;
             }
@@ -387,7 +410,7 @@ bool BGJoinAction::isUseful()
     return false;
 }
 
-bool BGJoinAction::JoinQueue(uint32 type)
+bool BGJoinAction::JoinQueue(uint32 type, bool fillDemand)
 {
     // ignore if player is already in BG, is logging out, or already being teleport
     if (!bot || (!bot->IsInWorld() && !bot->IsBeingTeleported()) || bot->InBattleground())
@@ -487,8 +510,8 @@ bool BGJoinAction::JoinQueue(uint32 type)
     if (isArena)
     {
         isArena = true;
-        BracketSize = type * 2;
-        TeamSize = type;
+        BracketSize = arenaType * 2;
+        TeamSize = arenaType;
         isRated = botAI->GetAiObjectContext()->GetValue<uint32>("arena type")->Get();
 
         if (joinAsGroup)
@@ -513,38 +536,54 @@ bool BGJoinAction::JoinQueue(uint32 type)
         }
     }
 
-    LOG_INFO("playerbots", "Bot {} {}:{} <{}> queued {} {}", bot->GetGUID().ToString().c_str(),
-             bot->GetTeamId() == TEAM_ALLIANCE ? "A" : "H", bot->GetLevel(), bot->GetName().c_str(), _bgType.c_str(),
-             isRated   ? "Rated Arena"
-             : isArena ? "Arena"
-                       : "");
-
-    if (isArena)
+    // same limits as shouldJoinBg, checked again as other bots may have filled the queue since
+    BattlegroundInfo& demand = sRandomPlayerbotMgr->BattlegroundData[queueTypeId][bracketId];
+    std::atomic<uint32>* botCount = nullptr;
+    uint32 playerCount = 0;
+    uint32 cap = 0;
+    uint32 count = 1;
+    if (isRated)
     {
-        if (!isRated)
-        {
-            sRandomPlayerbotMgr->BattlegroundData[queueTypeId][bracketId].skirmishArenaBotCount++;
-        }
+        botCount = &demand.ratedArenaBotCount;
+        playerCount = demand.ratedArenaPlayerCount;
+        cap = BracketSize * (demand.activeRatedArenaQueue + demand.ratedArenaInstanceCount);
+        count = TeamSize;
     }
-    else if (!joinAsGroup)
+    else if (isArena)
     {
-        if (teamId == TEAM_ALLIANCE)
-            sRandomPlayerbotMgr->BattlegroundData[queueTypeId][bracketId].bgAllianceBotCount++;
-        else
-            sRandomPlayerbotMgr->BattlegroundData[queueTypeId][bracketId].bgHordeBotCount++;
+        botCount = &demand.skirmishArenaBotCount;
+        playerCount = demand.skirmishArenaPlayerCount;
+        cap = BracketSize * (demand.activeSkirmishArenaQueue + demand.skirmishArenaInstanceCount);
+        if (cap)
+            cap += TeamSize;
     }
     else
     {
-        if (teamId == TEAM_ALLIANCE)
-            sRandomPlayerbotMgr->BattlegroundData[queueTypeId][bracketId].bgAllianceBotCount +=
-                bot->GetGroup()->GetMembersCount();
-        else
-            sRandomPlayerbotMgr->BattlegroundData[queueTypeId][bracketId].bgHordeBotCount +=
-                bot->GetGroup()->GetMembersCount();
+        botCount = teamId == TEAM_ALLIANCE ? &demand.bgAllianceBotCount : &demand.bgHordeBotCount;
+        playerCount = teamId == TEAM_ALLIANCE ? demand.bgAlliancePlayerCount : demand.bgHordePlayerCount;
+        cap = TeamSize * (demand.activeBgQueue + demand.bgInstanceCount);
+        if (joinAsGroup)
+            count = bot->GetGroup()->GetMembersCount();
     }
 
     botAI->GetAiObjectContext()->GetValue<uint32>("bg type")->Set(0);
 
+    // explicit joins (rpg battlemaster visits) do not depend on demand, they are only counted
+    if (!fillDemand)
+        *botCount += count;
+    else if (!ReserveQueueSlots(*botCount, playerCount, count, cap))
+    {
+        LOG_DEBUG("playerbots", "Bot {} skipped {}, the queue filled up", bot->GetGUID().ToString().c_str(),
+                  _bgType.c_str());
+        return false;
+    }
+
+    LOG_INFO("playerbots", "Bot {} {}:{} <{}> queued {} {}", bot->GetGUID().ToString().c_str(),
+             bot->GetTeamId() == TEAM_ALLIANCE ? "A" : "H", bot->GetLevel(), bot->GetName().c_str(), _bgType.c_str(),
+             isRated   ? "Rated Arena"
+             : isArena ? "Arena"
+                       : "");
+
     if (!isArena)
     {
         WorldPacket* packet = new WorldPacket(CMSG_BATTLEMASTER_JOIN, 20);
@@ -558,6 +597,13 @@ bool BGJoinAction::JoinQueue(uint32 type)
         WorldPacket arena_packet(CMSG_BATTLEMASTER_JOIN_ARENA, 20);
         arena_packet << unit->GetGUID() << arenaslot << asGroup << uint8(isRated);
         bot->GetSession()->HandleBattlemasterJoinArena(arena_packet);
+
+        // the arena join is handled right away, a refused one must not keep the slots
+        if (!bot->InBattlegroundQueueForBattlegroundQueueType(queueTypeId))
+        {
+            ReleaseQueueSlots(*botCount, count);
+            return false;
+        }
     }
 
     return true;
@@ -601,9 +647,9 @@ bool FreeBGJoinAction::shouldJoinBg(BattlegroundQueueTypeId queueTypeId, Battleg
 
         if (isRated)
         {
+            // the slots are reserved by JoinQueue once the bot picked this queue
             if (sArenaTeamMgr->GetArenaTeamByCaptain(bot->GetGUID(), type))
             {
-                sRandomPlayerbotMgr->BattlegroundData[queueTypeId][bracketId].ratedArenaBotCount += TeamSize;
                 ratedList.push_back(queueTypeId);
                 return true;
             }
@@ -29,7 +29,8 @@ public:
     virtual bool gatherArenaTeam(ArenaType type);
 
 protected:
-    bool JoinQueue(uint32 type);
+    // fillDemand joins only while the queue still wants bots, the slots are reserved atomically
+    bool JoinQueue(uint32 type, bool fillDemand = false);
     std::vector<uint32> bgList;
     std::vector<uint32> ratedList;
 };
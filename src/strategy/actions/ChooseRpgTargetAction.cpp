@@ -17,6 +17,7 @@
 #include "Util.h"
 #include "ServerFacade.h"
 #include "PossibleRpgTargetsValue.h"
+#include "RpgTriggers.h"
 
 bool ChooseRpgTargetAction::HasSameTarget(ObjectGuid guid, uint32 max, GuidVector const& nearGuids)
 {
@@ -49,70 +50,68 @@ bool ChooseRpgTargetAction::HasSameTarget(ObjectGuid guid, uint32 max, GuidVecto
     return num > 0;
 }
 
-float ChooseRpgTargetAction::getMaxRelevance(GuidPosition guidP)
+std::vector<ChooseRpgTargetAction::RpgRelevanceRule> const& ChooseRpgTargetAction::GetRelevanceRules()
 {
-    GuidPosition currentRpgTarget = AI_VALUE(GuidPosition, "rpg target");
-    SET_AI_VALUE(GuidPosition, "rpg target", guidP);
+    if (relevanceRulesBuilt)
+        return relevanceRules;
+
+    relevanceRulesBuilt = true;
 
     Strategy* rpgStrategy = botAI->GetAiObjectContext()->GetStrategy("rpg");
-    if (!rpgStrategy) return 0.0f;
+    if (!rpgStrategy)
+        return relevanceRules;
 
     std::vector<TriggerNode*> triggerNodes;
     rpgStrategy->InitTriggers(triggerNodes);
 
-    float maxRelevance = 0.0f;
-
-    for (auto triggerNode : triggerNodes)
+    for (TriggerNode* triggerNode : triggerNodes)
     {
-        Trigger* trigger = context->GetTrigger(triggerNode->getName());
+        float relevance = triggerNode->getFirstRelevance();
+        RpgTrigger* trigger = dynamic_cast<RpgTrigger*>(context->GetTrigger(triggerNode->getName()));
 
-        if (trigger)
+        // only the sub action triggers tell something about a possible rpg target
+        if (trigger && relevance <= 2.0f)
         {
-            triggerNode->setTrigger(trigger);
-
-            if (triggerNode->getFirstRelevance() < maxRelevance || triggerNode->getFirstRelevance() > 2.0f)
-                continue;
-
-            Trigger* trigger = triggerNode->getTrigger();
-
-            if (!trigger->IsActive())
-                continue;
-
             NextAction** nextActions = triggerNode->getHandlers();
 
             bool isRpg = false;
-
             for (int32 i = 0; i < NextAction::size(nextActions); i++)
             {
-                NextAction* nextAction = nextActions[i];
-
-                Action* action = botAI->GetAiObjectContext()->GetAction(nextAction->getName());
-
+                Action* action = botAI->GetAiObjectContext()->GetAction(nextActions[i]->getName());
                 if (dynamic_cast<RpgEnabled*>(action))
                     isRpg = true;
             }
             NextAction::destroy(nextActions);
 
             if (isRpg)
-            {
-                maxRelevance = triggerNode->getFirstRelevance();
-                rgpActionReason[guidP] = triggerNode->getName();
-            }
+                relevanceRules.push_back({trigger, relevance, triggerNode->getName()});
         }
-    }
 
-    for (auto trigger : triggerNodes)
-    {
-        delete trigger;
+        delete triggerNode;
     }
-    triggerNodes.clear();
 
-    SET_AI_VALUE(GuidPosition, "rpg target", currentRpgTarget);
+    std::stable_sort(relevanceRules.begin(), relevanceRules.end(),
+                     [](RpgRelevanceRule const& lhs, RpgRelevanceRule const& rhs)
+                     { return lhs.relevance > rhs.relevance; });
 
-    if (!maxRelevance)
-        return 0.0;
+    return relevanceRules;
+}
+
+float ChooseRpgTargetAction::getMaxRelevance(GuidPosition guidP)
+{
+    RpgCandidate const candidate(botAI, guidP);
+
+    // most relevant first, the first sub action the target is good for wins
+    for (RpgRelevanceRule const& rule : GetRelevanceRules())
+    {
+        if (!rule.trigger->IsActiveFor(candidate))
+            continue;
+
+        rgpActionReason[guidP] = rule.name;
+        return floor((rule.relevance - 1.0) * 1000.0f);
+    }
 
-    return floor((maxRelevance - 1.0) * 1000.0f);
+    return 0.0;
 }
 
 bool ChooseRpgTargetAction::Execute(Event event)
@@ -12,6 +12,7 @@
 class GuidPosition;
 class Player;
 class PlayerbotAI;
+class RpgTrigger;
 class WorldObject;
 class WorldPosition;
 
@@ -27,10 +28,21 @@ public:
     static bool isFollowValid(Player* bot, WorldPosition pos);
 
 private:
+    // a sub action trigger of the rpg strategy with the relevance of its action
+    struct RpgRelevanceRule
+    {
+        RpgTrigger* trigger;
+        float relevance;
+        std::string name;
+    };
+
+    std::vector<RpgRelevanceRule> const& GetRelevanceRules();
     float getMaxRelevance(GuidPosition guidP);
     bool  HasSameTarget(ObjectGuid guid, uint32 max, GuidVector const& nearGuids);
 
     std::unordered_map <ObjectGuid, std::string> rgpActionReason;
+    std::vector<RpgRelevanceRule> relevanceRules;
+    bool relevanceRulesBuilt = false;
 };
 
 class ClearRpgTargetAction : public ChooseRpgTargetAction
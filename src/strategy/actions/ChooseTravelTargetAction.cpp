@@ -904,75 +904,28 @@ bool ChooseTravelTargetAction::needForQuest(Unit* target)
 {
     bool justCheck = (bot->GetGUID() == target->GetGUID());
 
-    QuestStatusMap& questMap = bot->getQuestStatusMap();
-    for (auto& quest : questMap)
+    PlayerbotQuestIndex& questIndex = botAI->GetQuestIndex();
+    for (uint32 questId : questIndex.GetCompleteQuests())
     {
-        Quest const* questTemplate = sObjectMgr->GetQuestTemplate(quest.first);
-        if (!questTemplate)
-            continue;
-
-        uint32 questId = questTemplate->GetQuestId();
-
-        if (!questId)
-            continue;
-
-        QuestStatus status = bot->GetQuestStatus(questId);
-
-        if ((status == QUEST_STATUS_COMPLETE && !bot->GetQuestRewardStatus(questId)))
-        {
-            if (!justCheck && !target->hasInvolvedQuest(questId))
-                continue;
-
+        if (justCheck || target->hasInvolvedQuest(questId))
             return true;
-        }
-        else if (status == QUEST_STATUS_INCOMPLETE)
-        {
-            QuestStatusData questStatus = quest.second;
-
-            if (questTemplate->GetQuestLevel() > bot->GetLevel())
-                continue;
-
-            for (int j = 0; j < QUEST_OBJECTIVES_COUNT; j++)
-            {
-                int32 entry = questTemplate->RequiredNpcOrGo[j];
-
-                if (entry && entry > 0)
-                {
-                    int required = questTemplate->RequiredNpcOrGoCount[j];
-                    int available = questStatus.CreatureOrGOCount[j];
-
-                    if (required && available < required && (target->GetEntry() == entry || justCheck))
-                        return true;
-                }
+    }
 
-                if (justCheck)
-                {
-                    int32 itemId = questTemplate->RequiredItemId[j];
+    if (justCheck)
+        return questIndex.HasOutstandingObjectives(bot->GetLevel());
 
-                    if (itemId && itemId > 0)
-                    {
-                        int required = questTemplate->RequiredItemCount[j];
-                        int available = questStatus.ItemCount[j];
+    if (questIndex.NeedsNpcOrGo(target->GetEntry(), bot->GetLevel()))
+        return true;
 
-                        if (required && available < required)
-                            return true;
-                    }
-                }
-            }
+    if (!questIndex.HasIncompleteQuest(bot->GetLevel()))
+        return false;
 
-            if (!justCheck)
-            {
-                if (CreatureTemplate const* data = sObjectMgr->GetCreatureTemplate(target->GetEntry()))
-                {
-                    if (uint32 lootId = data->lootid)
-                    {
-                        if (LootTemplates_Creature.HaveQuestLootForPlayer(lootId, bot))
-                            return true;
-                    }
-                }
-            }
-        }
+    if (CreatureTemplate const* data = sObjectMgr->GetCreatureTemplate(target->GetEntry()))
+    {
+        if (uint32 lootId = data->lootid)
+            return questIndex.HasQuestLoot(lootId, bot);
     }
+
     return false;
 }
 
@@ -259,6 +259,19 @@ bool DebugAction::Execute(Event event)
         sTravelNodeMap->removeUselessPaths();
         return true;
     }
+    else if (text.find("export node") != std::string::npos)
+    {
+        sTravelNodeMap->saveNodeStoreToDb();
+        return true;
+    }
+    else if (text.find("import node") != std::string::npos)
+    {
+        std::thread t([] { sTravelNodeMap->importNodeStoreFromDb(); });
+
+        t.detach();
+
+        return true;
+    }
     else if (text.find("save node") != std::string::npos)
     {
         sTravelNodeMap->printNodeStore();
@@ -8,6 +8,7 @@
 #include <ctime>
 
 #include "Event.h"
+#include "HealTriageBoard.h"
 #include "ItemTemplate.h"
 #include "ObjectDefines.h"
 #include "Opcodes.h"
@@ -214,6 +215,19 @@ CastHealingSpellAction::CastHealingSpellAction(PlayerbotAI* botAI, std::string c
 
 bool CastHealingSpellAction::isUseful() { return CastAuraSpellAction::isUseful(); }
 
+bool HealPartyMemberAction::Execute(Event event)
+{
+    Unit* target = GetTarget();
+    if (!target || !botAI->CastSpell(spell, target))
+        return false;
+
+    // other healers of the group skip the target until the claim expires
+    if (std::shared_ptr<HealTriageBoard> board = sHealTriageBoardMgr->GetBoard(bot))
+        board->Claim(target->GetGUID(), bot->GetGUID(), getMSTime());
+
+    return true;
+}
+
 bool CastAoeHealSpellAction::isUseful() { return CastSpellAction::isUseful(); }
 
 CastCureSpellAction::CastCureSpellAction(PlayerbotAI* botAI, std::string const spell) : CastSpellAction(botAI, spell)
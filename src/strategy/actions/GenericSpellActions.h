@@ -183,6 +183,7 @@ public:
     {
     }
 
+    bool Execute(Event event) override;
     std::string const GetTargetName() override { return "party member to heal"; }
     std::string const getName() override { return PartyMemberActionNameSupport::getName(); }
 };
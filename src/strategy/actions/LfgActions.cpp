@@ -98,43 +98,34 @@ bool LfgJoinAction::JoinLFG()
     bool rbotAId = !heroic && (urand(0, 100) < 50 && visitor.count[ITEM_QUALITY_EPIC] >= 5 &&
                                (bot->GetLevel() == 60 || bot->GetLevel() == 70 || bot->GetLevel() == 80));*/
 
-    LfgDungeonSet list;
-    std::vector<uint32> selected;
-
-    std::vector<uint32> dungeons = sRandomPlayerbotMgr->LfgDungeons[bot->GetTeamId()];
-    if (!dungeons.size())
-        return false;
-
-    for (std::vector<uint32>::iterator i = dungeons.begin(); i != dungeons.end(); ++i)
+    uint32 roleMask = GetRoles();
+    uint8 botLevel = bot->GetLevel();
+    auto suitable = [botLevel](uint32 dungeonId)
     {
-        LFGDungeonEntry const* dungeon = sLFGDungeonStore.LookupEntry(*i);
+        LFGDungeonEntry const* dungeon = sLFGDungeonStore.LookupEntry(dungeonId);
         if (!dungeon || (dungeon->TypeID != LFG_TYPE_RANDOM && dungeon->TypeID != LFG_TYPE_DUNGEON &&
                          dungeon->TypeID != LFG_TYPE_HEROIC && dungeon->TypeID != LFG_TYPE_RAID))
-            continue;
-
-        auto const& botLevel = bot->GetLevel();
+            return false;
 
         /*LFG_TYPE_RANDOM on classic is 15-58 so bot over level 25 will never queue*/
         if (dungeon->MinLevel && (botLevel < dungeon->MinLevel || botLevel > dungeon->MaxLevel) ||
             (botLevel > dungeon->MinLevel + 10 && dungeon->TypeID == LFG_TYPE_DUNGEON))
-            continue;
+            return false;
 
-        selected.push_back(dungeon->ID);
-        list.insert(dungeon->ID);
-    }
-
-    if (!selected.size())
-        return false;
+        return true;
+    };
 
-    if (list.empty())
+    // only queue for a role a waiting real player still misses
+    std::vector<uint32> selected;
+    if (!sRandomPlayerbotMgr->ClaimLfgSlot(bot, roleMask, suitable, selected))
         return false;
 
+    LfgDungeonSet list(selected.begin(), selected.end());
     bool many = list.size() > 1;
     LFGDungeonEntry const* dungeon = sLFGDungeonStore.LookupEntry(*list.begin());
 
     // check role for console msg
     std::string _roles = "multiple roles";
-    uint32 roleMask = GetRoles();
     if (roleMask & PLAYER_ROLE_TANK)
         _roles = "TANK";
 
@@ -9,6 +9,7 @@
 #include "GridTerrainData.h"
 #include "IVMapMgr.h"
 #include "NewRpgInfo.h"
+#include "NewRpgQuestPOICache.h"
 #include "NewRpgStrategy.h"
 #include "Object.h"
 #include "ObjectAccessor.h"
@@ -712,21 +713,25 @@ bool NewRpgBaseAction::HasQuestToAcceptOrReward(WorldObject* object)
     return false;
 }
 
-static std::vector<float> GenerateRandomWeights(int n)
+// one random sample of each poi area in the bot's zone and within reach
+static void AddQuestPOISamples(Player* bot, uint32 questId, int32 objectiveIdx, std::vector<POIInfo>& poiInfo)
 {
-    std::vector<float> weights(n);
-    float sum = 0.0;
-
-    for (int i = 0; i < n; ++i)
-    {
-        weights[i] = rand_norm();
-        sum += weights[i];
-    }
-    for (int i = 0; i < n; ++i)
+    for (QuestPOISamples const& area : sNewRpgQuestPOICache->GetSamples(bot->GetMap(), questId, objectiveIdx))
     {
-        weights[i] /= sum;
+        QuestPOISample const* picked = nullptr;
+        uint32 candidates = 0;
+        for (QuestPOISample const& sample : area)
+        {
+            if (sample.zoneId != bot->GetZoneId() || bot->GetDistance2d(sample.pos.x, sample.pos.y) >= 1500.0f)
+                continue;
+
+            if (urand(0, candidates++) == 0)
+                picked = &sample;
+        }
+
+        if (picked)
+            poiInfo.push_back({picked->pos, objectiveIdx});
     }
-    return weights;
 }
 
 bool NewRpgBaseAction::GetQuestPOIPosAndObjectiveIdx(uint32 questId, std::vector<POIInfo>& poiInfo, bool toComplete)
@@ -735,8 +740,7 @@ bool NewRpgBaseAction::GetQuestPOIPosAndObjectiveIdx(uint32 questId, std::vector
     if (!quest)
         return false;
 
-    const QuestPOIVector* poiVector = sObjectMgr->GetQuestPOIVector(questId);
-    if (!poiVector)
+    if (!sObjectMgr->GetQuestPOIVector(questId))
     {
         return false;
     }
@@ -745,40 +749,8 @@ bool NewRpgBaseAction::GetQuestPOIPosAndObjectiveIdx(uint32 questId, std::vector
 
     if (toComplete && q_status.Status == QUEST_STATUS_COMPLETE)
     {
-        for (const QuestPOI& qPoi : *poiVector)
-        {
-            if (qPoi.MapId != bot->GetMapId())
-                continue;
-
-            // not the poi pos to reward quest
-            if (qPoi.ObjectiveIndex != -1)
-                continue;
-
-            if (qPoi.points.size() == 0)
-                continue;
-
-            float dx = 0, dy = 0;
-            std::vector<float> weights = GenerateRandomWeights(qPoi.points.size());
-            for (size_t i = 0; i < qPoi.points.size(); i++)
-            {
-                const QuestPOIPoint& point = qPoi.points[i];
-                dx += point.x * weights[i];
-                dy += point.y * weights[i];
-            }
-
-            if (bot->GetDistance2d(dx, dy) >= 1500.0f)
-                continue;
-
-            float dz = std::max(bot->GetMap()->GetHeight(dx, dy, MAX_HEIGHT), bot->GetMap()->GetWaterLevel(dx, dy));
-
-            if (dz == INVALID_HEIGHT || dz == VMAP_INVALID_HEIGHT_VALUE)
-                continue;
-
-            if (bot->GetZoneId() != bot->GetMap()->GetZoneId(bot->GetPhaseMask(), dx, dy, dz))
-                continue;
-
-            poiInfo.push_back({{dx, dy}, qPoi.ObjectiveIndex});
-        }
+        // -1 is the poi pos to reward quest
+        AddQuestPOISamples(bot, questId, -1, poiInfo);
 
         if (poiInfo.empty())
             return false;
@@ -790,66 +762,13 @@ bool NewRpgBaseAction::GetQuestPOIPosAndObjectiveIdx(uint32 questId, std::vector
         return false;
 
     // Get incomplete quest objective index
-    std::vector<int32> incompleteObjectiveIdx;
-    for (int i = 0; i < QUEST_OBJECTIVES_COUNT; i++)
-    {
-        int32 npcOrGo = quest->RequiredNpcOrGo[i];
-        if (!npcOrGo)
-            continue;
-
-        if (q_status.CreatureOrGOCount[i] < quest->RequiredNpcOrGoCount[i])
-            incompleteObjectiveIdx.push_back(i);
-    }
-    for (int i = 0; i < QUEST_ITEM_OBJECTIVES_COUNT; i++)
-    {
-        uint32 itemId = quest->RequiredItemId[i];
-        if (!itemId)
-            continue;
-
-        if (q_status.ItemCount[i] < quest->RequiredItemCount[i])
-            incompleteObjectiveIdx.push_back(QUEST_OBJECTIVES_COUNT + i);
-    }
+    uint32 incompleteObjectives = botAI->GetQuestIndex().GetOutstandingObjectives(questId);
 
     // Get POIs to go
-    for (const QuestPOI& qPoi : *poiVector)
+    for (int32 objectiveIdx = 0; objectiveIdx < QUEST_OBJECTIVES_COUNT + QUEST_ITEM_OBJECTIVES_COUNT; ++objectiveIdx)
     {
-        if (qPoi.MapId != bot->GetMapId())
-            continue;
-
-        bool inComplete = false;
-        for (uint32 objective : incompleteObjectiveIdx)
-        {
-            if (qPoi.ObjectiveIndex == objective)
-            {
-                inComplete = true;
-                break;
-            }
-        }
-        if (!inComplete)
-            continue;
-        if (qPoi.points.size() == 0)
-            continue;
-        float dx = 0, dy = 0;
-        std::vector<float> weights = GenerateRandomWeights(qPoi.points.size());
-        for (size_t i = 0; i < qPoi.points.size(); i++)
-        {
-            const QuestPOIPoint& point = qPoi.points[i];
-            dx += point.x * weights[i];
-            dy += point.y * weights[i];
-        }
-
-        if (bot->GetDistance2d(dx, dy) >= 1500.0f)
-            continue;
-
-        float dz = std::max(bot->GetMap()->GetHeight(dx, dy, MAX_HEIGHT), bot->GetMap()->GetWaterLevel(dx, dy));
-
-        if (dz == INVALID_HEIGHT || dz == VMAP_INVALID_HEIGHT_VALUE)
-            continue;
-
-        if (bot->GetZoneId() != bot->GetMap()->GetZoneId(bot->GetPhaseMask(), dx, dy, dz))
-            continue;
-
-        poiInfo.push_back({{dx, dy}, qPoi.ObjectiveIndex});
+        if (incompleteObjectives & (1 << objectiveIdx))
+            AddQuestPOISamples(bot, questId, objectiveIdx, poiInfo);
     }
 
     if (poiInfo.size() == 0)
@@ -863,7 +782,6 @@ bool NewRpgBaseAction::GetQuestPOIPosAndObjectiveIdx(uint32 questId, std::vector
 
 WorldPosition NewRpgBaseAction::SelectRandomGrindPos(Player* bot)
 {
-    const std::vector<WorldLocation>& locs = sRandomPlayerbotMgr->locsPerLevelCache[bot->GetLevel()];
     float hiRange = 500.0f;
     float loRange = 2500.0f;
     if (bot->GetLevel() < 5)
@@ -871,7 +789,6 @@ WorldPosition NewRpgBaseAction::SelectRandomGrindPos(Player* bot)
         hiRange /= 3;
         loRange /= 3;
     }
-    std::vector<WorldLocation> lo_prepared_locs, hi_prepared_locs;
 
     bool inCity = false;
     if (AreaTableEntry const* zone = sAreaTableStore.LookupEntry(bot->GetZoneId()))
@@ -880,50 +797,46 @@ WorldPosition NewRpgBaseAction::SelectRandomGrindPos(Player* bot)
             inCity = true;
     }
 
-    for (auto& loc : locs)
+    // one random pick per range while visiting, nothing is collected
+    WorldLocation const* hiPick = nullptr;
+    WorldLocation const* loPick = nullptr;
+    uint32 hiCount = 0, loCount = 0;
+    size_t total = 0;
+    RpgLocationIndex const& index = sRandomPlayerbotMgr->rpgGrindLocations;
+    if (RpgLocationGrid const* locs = sRandomPlayerbotMgr->GetRpgLocations(index, bot->GetLevel(), bot->GetMapId()))
     {
-        if (bot->GetMapId() != loc.GetMapId())
-            continue;
-
-        if (bot->GetExactDist(loc) > 2500.0f)
-            continue;
-
-        if (!inCity && bot->GetMap()->GetZoneId(bot->GetPhaseMask(), loc.GetPositionX(), loc.GetPositionY(),
-                                                loc.GetPositionZ()) != bot->GetZoneId())
-            continue;
-
-        if (bot->GetExactDist(loc) < hiRange)
-        {
-            hi_prepared_locs.push_back(loc);
-        }
-
-        if (bot->GetExactDist(loc) < loRange)
-        {
-            lo_prepared_locs.push_back(loc);
-        }
+        total = locs->size();
+        locs->VisitRange(bot->GetPositionX(), bot->GetPositionY(), loRange,
+                         [&](RpgLocation const& location)
+                         {
+                             if (!inCity && location.zoneId != bot->GetZoneId())
+                                 return;
+
+                             float dist = bot->GetExactDist(location.loc);
+                             if (dist < hiRange && urand(0, hiCount++) == 0)
+                                 hiPick = &location.loc;
+
+                             if (dist < loRange && urand(0, loCount++) == 0)
+                                 loPick = &location.loc;
+                         });
     }
+
     WorldPosition dest{};
-    if (urand(1, 100) <= 50 && !hi_prepared_locs.empty())
-    {
-        uint32 idx = urand(0, hi_prepared_locs.size() - 1);
-        dest = hi_prepared_locs[idx];
-    }
-    else if (!lo_prepared_locs.empty())
-    {
-        uint32 idx = urand(0, lo_prepared_locs.size() - 1);
-        dest = lo_prepared_locs[idx];
-    }
+    if (urand(1, 100) <= 50 && hiPick)
+        dest = *hiPick;
+    else if (loPick)
+        dest = *loPick;
+
     LOG_DEBUG("playerbots", "[New RPG] Bot {} select random grind pos Map:{} X:{} Y:{} Z:{} ({}+{} available in {})",
               bot->GetName(), dest.GetMapId(), dest.GetPositionX(), dest.GetPositionY(), dest.GetPositionZ(),
-              hi_prepared_locs.size(), lo_prepared_locs.size() - hi_prepared_locs.size(), locs.size());
+              hiCount, loCount - hiCount, total);
     return dest;
 }
 
 WorldPosition NewRpgBaseAction::SelectRandomCampPos(Player* bot)
 {
-    const std::vector<WorldLocation>& locs = IsAlliance(bot->getRace())
-                                                 ? sRandomPlayerbotMgr->allianceStarterPerLevelCache[bot->GetLevel()]
-                                                 : sRandomPlayerbotMgr->hordeStarterPerLevelCache[bot->GetLevel()];
+    RpgLocationIndex const& index = IsAlliance(bot->getRace()) ? sRandomPlayerbotMgr->rpgAllianceCampLocations
+                                                                : sRandomPlayerbotMgr->rpgHordeCampLocations;
 
     bool inCity = false;
 
@@ -933,116 +846,93 @@ WorldPosition NewRpgBaseAction::SelectRandomCampPos(Player* bot)
             inCity = true;
     }
 
-    std::vector<WorldLocation> prepared_locs;
-    for (auto& loc : locs)
+    float range = bot->GetLevel() <= 5 ? 500.0f : 2500.0f;
+    WorldLocation const* pick = nullptr;
+    uint32 count = 0;
+    size_t total = 0;
+    if (RpgLocationGrid const* locs = sRandomPlayerbotMgr->GetRpgLocations(index, bot->GetLevel(), bot->GetMapId()))
     {
-        if (bot->GetMapId() != loc.GetMapId())
-            continue;
-
-        float range = bot->GetLevel() <= 5 ? 500.0f : 2500.0f;
-        if (bot->GetExactDist(loc) > range)
-            continue;
-
-        if (bot->GetExactDist(loc) < 50.0f)
-            continue;
-
-        if (!inCity && bot->GetMap()->GetZoneId(bot->GetPhaseMask(), loc.GetPositionX(), loc.GetPositionY(),
-                                                loc.GetPositionZ()) != bot->GetZoneId())
-            continue;
-
-        prepared_locs.push_back(loc);
+        total = locs->size();
+        locs->VisitRange(bot->GetPositionX(), bot->GetPositionY(), range,
+                         [&](RpgLocation const& location)
+                         {
+                             float dist = bot->GetExactDist(location.loc);
+                             if (dist > range || dist < 50.0f)
+                                 return;
+
+                             if (!inCity && location.zoneId != bot->GetZoneId())
+                                 return;
+
+                             if (urand(0, count++) == 0)
+                                 pick = &location.loc;
+                         });
     }
+
     WorldPosition dest{};
-    if (!prepared_locs.empty())
-    {
-        uint32 idx = urand(0, prepared_locs.size() - 1);
-        dest = prepared_locs[idx];
-    }
+    if (pick)
+        dest = *pick;
+
     LOG_DEBUG("playerbots", "[New RPG] Bot {} select random inn keeper pos Map:{} X:{} Y:{} Z:{} ({} available in {})",
               bot->GetName(), dest.GetMapId(), dest.GetPositionX(), dest.GetPositionY(), dest.GetPositionZ(),
-              prepared_locs.size(), locs.size());
+              count, total);
     return dest;
 }
 
 bool NewRpgBaseAction::SelectRandomFlightTaxiNode(ObjectGuid& flightMaster, uint32& fromNode, uint32& toNode)
 {
-    const std::vector<uint32>& flightMasters = IsAlliance(bot->getRace())
-                                                   ? sRandomPlayerbotMgr->allianceFlightMasterCache
-                                                   : sRandomPlayerbotMgr->hordeFlightMasterCache;
+    TeamId teamId = IsAlliance(bot->getRace()) ? TEAM_ALLIANCE : TEAM_HORDE;
+    std::vector<RpgFlightMaster const*> candidates;
+    sRandomPlayerbotMgr->FindRpgFlightMasters(teamId, bot->GetMapId(), bot->GetPositionX(), bot->GetPositionY(), 500.0f,
+                                              candidates);
+
+    // the nearest spawn may be despawned or in another phase, fall back to the next one
+    RpgFlightMaster const* nearest = nullptr;
     Creature* nearestFlightMaster = nullptr;
-    for (const uint32& guid : flightMasters)
+    for (RpgFlightMaster const* candidate : candidates)
     {
-        Creature* flightMaster = ObjectAccessor::GetSpawnedCreatureByDBGUID(bot->GetMapId(), guid);
-        if (!flightMaster)
-            continue;
-
-        if (bot->GetMapId() != flightMaster->GetMapId())
-            continue;
-
-        if (!nearestFlightMaster || bot->GetDistance(nearestFlightMaster) > bot->GetDistance(flightMaster))
-            nearestFlightMaster = flightMaster;
+        Creature* creature = ObjectAccessor::GetSpawnedCreatureByDBGUID(bot->GetMapId(), candidate->guid);
+        if (creature && bot->GetDistance(creature) <= 500.0f)
+        {
+            nearest = candidate;
+            nearestFlightMaster = creature;
+            break;
+        }
     }
-    if (!nearestFlightMaster || bot->GetDistance(nearestFlightMaster) > 500.0f)
+
+    if (!nearest)
         return false;
 
-    fromNode = sObjectMgr->GetNearestTaxiNode(nearestFlightMaster->GetPositionX(), nearestFlightMaster->GetPositionY(),
-                                              nearestFlightMaster->GetPositionZ(), nearestFlightMaster->GetMapId(),
-                                              bot->GetTeamId());
+    fromNode = nearest->taxiNode;
 
-    if (!fromNode)
+    // routes with a path to a zone of the bot's level, prepared at startup
+    std::vector<uint32> const* destinations =
+        sRandomPlayerbotMgr->GetRpgTaxiDestinations(bot->GetTeamId(), fromNode, bot->GetLevel());
+    if (!destinations)
         return false;
 
-    std::vector<uint32> availableToNodes;
-    for (uint32 i = 1; i < sTaxiNodesStore.GetNumRows(); ++i)
+    uint32 available = 0;
+    for (uint32 node : *destinations)
     {
-        if (fromNode == i)
-            continue;
-
-        TaxiNodesEntry const* node = sTaxiNodesStore.LookupEntry(i);
-
-        // check map
-        if (!node || node->map_id != bot->GetMapId() ||
-            (!node->MountCreatureID[bot->GetTeamId() == TEAM_ALLIANCE ? 1 : 0]))  // dk flight
-            continue;
-
         // check taxi node known
-        if (!bot->isTaxiCheater() && !bot->m_taxi.IsTaximaskNodeKnown(i))
+        if (!bot->isTaxiCheater() && !bot->m_taxi.IsTaximaskNodeKnown(node))
             continue;
 
         // check distance by level
-        if (!botAI->CheckLocationDistanceByLevel(bot, WorldLocation(node->map_id, node->x, node->y, node->z), false))
+        TaxiNodesEntry const* nodeEntry = sTaxiNodesStore.LookupEntry(node);
+        if (!botAI->CheckLocationDistanceByLevel(
+                bot, WorldLocation(nodeEntry->map_id, nodeEntry->x, nodeEntry->y, nodeEntry->z), false))
             continue;
 
-        // check path
-        uint32 path, cost;
-        sObjectMgr->GetTaxiPath(fromNode, i, path, cost);
-        if (!path)
-            continue;
-
-        // check area level
-        uint32 nodeZoneId = bot->GetMap()->GetZoneId(bot->GetPhaseMask(), node->x, node->y, node->z);
-        bool capital = false;
-        if (AreaTableEntry const* zone = sAreaTableStore.LookupEntry(nodeZoneId))
-        {
-            capital = zone->flags & AREA_FLAG_CAPITAL;
-        }
-
-        auto itr = sRandomPlayerbotMgr->zone2LevelBracket.find(nodeZoneId);
-        if (!capital && itr == sRandomPlayerbotMgr->zone2LevelBracket.end())
-            continue;
-
-        if (!capital && (bot->GetLevel() < itr->second.low || bot->GetLevel() > itr->second.high))
-            continue;
-
-        availableToNodes.push_back(i);
+        if (urand(0, available++) == 0)
+            toNode = node;
     }
-    if (availableToNodes.empty())
+
+    if (!available)
         return false;
 
     flightMaster = nearestFlightMaster->GetGUID();
-    toNode = availableToNodes[urand(0, availableToNodes.size() - 1)];
     LOG_DEBUG("playerbots", "[New RPG] Bot {} select random flight taxi node from:{} (node {}) to:{} ({} available)",
-              bot->GetName(), flightMaster.GetEntry(), fromNode, toNode, availableToNodes.size());
+              bot->GetName(), flightMaster.GetEntry(), fromNode, toNode, available);
     return true;
 }
 
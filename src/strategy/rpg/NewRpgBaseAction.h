@@ -2,6 +2,7 @@
 #define _PLAYERBOT_NEWRPGBASEACTION_H
 
 #include "Duration.h"
+#include "G3D/Vector3.h"
 #include "LastMovementValue.h"
 #include "MovementActions.h"
 #include "NewRpgInfo.h"
@@ -15,7 +16,8 @@
 
 struct POIInfo
 {
-    G3D::Vector2 pos;
+    // ground position, validated when the poi was sampled
+    G3D::Vector3 pos;
     int32 objectiveIdx;
 };
 
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "NewRpgQuestPOICache.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include "GridTerrainData.h"
+#include "IVMapMgr.h"
+#include "Map.h"
+#include "ObjectMgr.h"
+#include "Random.h"
+
+std::vector<QuestPOISamples> const& NewRpgQuestPOICache::GetSamples(Map* map, uint32 questId, int32 objectiveIdx)
+{
+    POIKey const key(questId, objectiveIdx, map->GetId());
+
+    {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        auto it = samples.find(key);
+        if (it != samples.end())
+            return it->second;
+    }
+
+    // sampled without the lock, if another thread was faster its samples are kept
+    std::vector<QuestPOISamples> built = BuildSamples(map, questId, objectiveIdx);
+
+    std::unique_lock<std::shared_mutex> guard(lock);
+    return samples.emplace(key, std::move(built)).first->second;
+}
+
+std::vector<QuestPOISamples> NewRpgQuestPOICache::BuildSamples(Map* map, uint32 questId, int32 objectiveIdx) const
+{
+    std::vector<QuestPOISamples> areas;
+
+    QuestPOIVector const* poiVector = sObjectMgr->GetQuestPOIVector(questId);
+    if (!poiVector)
+        return areas;
+
+    std::vector<float> weights;
+    for (QuestPOI const& qPoi : *poiVector)
+    {
+        if (qPoi.MapId != map->GetId() || qPoi.ObjectiveIndex != objectiveIdx || qPoi.points.empty())
+            continue;
+
+        QuestPOISamples area;
+        weights.resize(qPoi.points.size());
+        for (uint32 sample = 0; sample < SAMPLES_PER_POI; ++sample)
+        {
+            float sum = 0.0f;
+            for (float& weight : weights)
+            {
+                weight = rand_norm();
+                sum += weight;
+            }
+
+            float dx = 0, dy = 0;
+            for (size_t i = 0; i < qPoi.points.size(); ++i)
+            {
+                dx += qPoi.points[i].x * weights[i] / sum;
+                dy += qPoi.points[i].y * weights[i] / sum;
+            }
+
+            float dz = std::max(map->GetHeight(dx, dy, MAX_HEIGHT), map->GetWaterLevel(dx, dy));
+            if (dz == INVALID_HEIGHT || dz == VMAP_INVALID_HEIGHT_VALUE)
+                continue;
+
+            area.push_back({{dx, dy, dz}, map->GetZoneId(PHASEMASK_NORMAL, dx, dy, dz)});
+        }
+
+        if (!area.empty())
+            areas.push_back(std::move(area));
+    }
+
+    return areas;
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_NEWRPGQUESTPOICACHE_H
+#define _PLAYERBOT_NEWRPGQUESTPOICACHE_H
+
+#include <map>
+#include <shared_mutex>
+#include <tuple>
+#include <vector>
+
+#include "Define.h"
+#include "G3D/Vector3.h"
+
+class Map;
+
+struct QuestPOISample
+{
+    G3D::Vector3 pos;
+    uint32 zoneId;
+};
+
+// validated samples of one poi area
+typedef std::vector<QuestPOISample> QuestPOISamples;
+
+/**
+ * @brief Ground positions inside the quest poi areas, shared by all bots
+ *
+ * Each area of a quest objective is sampled once per map with random weighted centroids of its points. Samples
+ * without ground are dropped and the rest keep their height and zone, so bots picking a quest destination only filter
+ * by zone and distance. Entries are never removed, the set of quest pois is fixed.
+ */
+class NewRpgQuestPOICache
+{
+public:
+    static NewRpgQuestPOICache* instance()
+    {
+        static NewRpgQuestPOICache instance;
+        return &instance;
+    }
+
+    // samples of every poi area of the objective (-1 for the turn in) on the map, computed on first use
+    std::vector<QuestPOISamples> const& GetSamples(Map* map, uint32 questId, int32 objectiveIdx);
+
+private:
+    static constexpr uint32 SAMPLES_PER_POI = 8;
+
+    // quest, objective, map
+    typedef std::tuple<uint32, int32, uint32> POIKey;
+
+    std::vector<QuestPOISamples> BuildSamples(Map* map, uint32 questId, int32 objectiveIdx) const;
+
+    std::shared_mutex lock;
+    std::map<POIKey, std::vector<QuestPOISamples>> samples;
+};
+
+#define sNewRpgQuestPOICache NewRpgQuestPOICache::instance()
+
+#endif
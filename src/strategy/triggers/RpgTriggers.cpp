@@ -25,9 +25,50 @@ bool NearRpgTargetTrigger::IsActive()
     return !NoRpgTargetTrigger::IsActive() && !FarFromRpgTargetTrigger::IsActive();
 }
 
+RpgCandidate::RpgCandidate(PlayerbotAI* botAI, GuidPosition const& target) : guidP(target), botAI(botAI)
+{
+    if (guidP.IsCreature())
+    {
+        creatureInfo = guidP.GetCreatureTemplate();
+        npcFlags = creatureInfo ? creatureInfo->npcflag : 0;
+    }
+    else if (guidP.IsGameObject())
+        goInfo = guidP.GetGameObjectTemplate();
+}
+
+uint32 RpgCandidate::GetDialogStatus() const
+{
+    if (dialogStatus)
+        return *dialogStatus;
+
+    AiObjectContext* context = botAI->GetAiObjectContext();
+
+    // quest relations of gameobjects are looked up by negative entry
+    dialogStatus = DIALOG_STATUS_NONE;
+    if (HasNpcFlag(UNIT_NPC_FLAG_QUESTGIVER))
+        dialogStatus = AI_VALUE2(uint32, "dialog status", guidP.GetEntry());
+    else if (goInfo)
+        dialogStatus = AI_VALUE2(uint32, "dialog status", -int32(guidP.GetEntry()));
+
+    return *dialogStatus;
+}
+
+uint32 RpgCandidate::GetTaxiNode() const
+{
+    if (taxiNode)
+        return *taxiNode;
+
+    taxiNode = 0;
+    if (HasNpcFlag(UNIT_NPC_FLAG_FLIGHTMASTER))
+        taxiNode = sObjectMgr->GetNearestTaxiNode(guidP.getX(), guidP.getY(), guidP.getZ(), guidP.getMapId(),
+                                                  botAI->GetBot()->GetTeamId());
+
+    return *taxiNode;
+}
+
 GuidPosition RpgTrigger::getGuidP() { return AI_VALUE(GuidPosition, "rpg target"); }
 
-bool RpgTrigger::IsActive() { return true; }
+bool RpgTrigger::IsActive() { return IsActiveFor(RpgCandidate(botAI, getGuidP())); }
 
 Event RpgTrigger::Check()
 {
@@ -38,89 +79,69 @@ Event RpgTrigger::Check()
     return Event();
 }
 
-bool RpgTaxiTrigger::IsActive()
+bool RpgTaxiTrigger::IsActiveFor(RpgCandidate const& candidate)
 {
-    GuidPosition guidP(getGuidP());
-
-    if (!guidP.HasNpcFlag(UNIT_NPC_FLAG_FLIGHTMASTER))
+    if (!candidate.HasNpcFlag(UNIT_NPC_FLAG_FLIGHTMASTER))
         return false;
 
-    uint32 node =
-        sObjectMgr->GetNearestTaxiNode(guidP.getX(), guidP.getY(), guidP.getZ(), guidP.getMapId(), bot->GetTeamId());
-
-    if (!node)
+    uint32 const taxiNode = candidate.GetTaxiNode();
+    if (!taxiNode)
         return false;
 
-    if (!bot->m_taxi.IsTaximaskNodeKnown(node))
+    if (!bot->m_taxi.IsTaximaskNodeKnown(taxiNode))
         return false;
 
     return true;
 }
 
-bool RpgDiscoverTrigger::IsActive()
+bool RpgDiscoverTrigger::IsActiveFor(RpgCandidate const& candidate)
 {
-    GuidPosition guidP(getGuidP());
-
-    if (!guidP.HasNpcFlag(UNIT_NPC_FLAG_FLIGHTMASTER))
+    if (!candidate.HasNpcFlag(UNIT_NPC_FLAG_FLIGHTMASTER))
         return false;
 
     if (bot->isTaxiCheater())
         return false;
 
-    uint32 node =
-        sObjectMgr->GetNearestTaxiNode(guidP.getX(), guidP.getY(), guidP.getZ(), guidP.getMapId(), bot->GetTeamId());
-
-    if (bot->m_taxi.IsTaximaskNodeKnown(node))
+    if (bot->m_taxi.IsTaximaskNodeKnown(candidate.GetTaxiNode()))
         return false;
 
     return true;
 }
 
-bool RpgStartQuestTrigger::IsActive()
+bool RpgStartQuestTrigger::IsActiveFor(RpgCandidate const& candidate)
 {
-    GuidPosition guidP(getGuidP());
-
-    if (!guidP.IsCreature() && !guidP.IsGameObject())
+    if (!candidate.guidP.IsCreature() && !candidate.guidP.IsGameObject())
         return false;
 
+    uint32 const dialogStatus = candidate.GetDialogStatus();
     if (AI_VALUE(bool, "can fight equal"))
-    {
-        if (AI_VALUE2(bool, "can accept quest npc", guidP.GetEntry()))
-            return true;
-    }
-    else
-    {
-        if (AI_VALUE2(bool, "can accept quest low level npc", guidP.GetEntry()))
-            return true;
-    }
+        return dialogStatus == DIALOG_STATUS_AVAILABLE;
 
-    return false;
+    return dialogStatus == DIALOG_STATUS_LOW_LEVEL_AVAILABLE;
 }
 
-bool RpgEndQuestTrigger::IsActive()
+bool RpgEndQuestTrigger::IsActiveFor(RpgCandidate const& candidate)
 {
-    GuidPosition guidP(getGuidP());
-
-    if (!guidP.IsCreature() && !guidP.IsGameObject())
+    if (!candidate.guidP.IsCreature() && !candidate.guidP.IsGameObject())
         return false;
 
-    if (AI_VALUE2(bool, "can turn in quest npc", guidP.GetEntry()))
+    uint32 const dialogStatus = candidate.GetDialogStatus();
+    if (dialogStatus == DIALOG_STATUS_REWARD2 || dialogStatus == DIALOG_STATUS_REWARD ||
+        dialogStatus == DIALOG_STATUS_REWARD_REP)
         return true;
 
-    if (!AI_VALUE2(bool, "can accept quest low level npc", guidP.GetEntry()))
+    if (dialogStatus != DIALOG_STATUS_LOW_LEVEL_AVAILABLE)
         return false;
 
-    if (guidP.GetEntry() == AI_VALUE(TravelTarget*, "travel target")->getEntry())
+    if (candidate.guidP.GetEntry() == AI_VALUE(TravelTarget*, "travel target")->getEntry())
         return true;
 
     return false;
 }
 
-bool RpgBuyTrigger::IsActive()
+bool RpgBuyTrigger::IsActiveFor(RpgCandidate const& candidate)
 {
-    GuidPosition guidP(getGuidP());
-
-    if (!guidP.HasNpcFlag(UNIT_NPC_FLAG_VENDOR))
+    if (!candidate.HasNpcFlag(UNIT_NPC_FLAG_VENDOR))
         return false;
 
     if (AI_VALUE(uint8, "durability") > 50)
@@ -132,11 +153,9 @@ bool RpgBuyTrigger::IsActive()
     return true;
 }
 
-bool RpgSellTrigger::IsActive()
+bool RpgSellTrigger::IsActiveFor(RpgCandidate const& candidate)
 {
-    GuidPosition guidP(getGuidP());
-
-    if (!guidP.HasNpcFlag(UNIT_NPC_FLAG_VENDOR))
+    if (!candidate.HasNpcFlag(UNIT_NPC_FLAG_VENDOR))
         return false;
 
     if (!AI_VALUE(bool, "can sell"))
@@ -145,11 +164,9 @@ bool RpgSellTrigger::IsActive()
     return true;
 }
 
-bool RpgRepairTrigger::IsActive()
+bool RpgRepairTrigger::IsActiveFor(RpgCandidate const& candidate)
 {
-    GuidPosition guidP(getGuidP());
-
-    if (!guidP.HasNpcFlag(UNIT_NPC_FLAG_REPAIR))
+    if (!candidate.HasNpcFlag(UNIT_NPC_FLAG_REPAIR))
         return false;
 
     if (AI_VALUE2_LAZY(bool, "group or", "should sell,can sell,following party,near leader"))
@@ -202,20 +219,18 @@ bool RpgTrainTrigger::IsTrainerOf(CreatureTemplate const* cInfo, Player* pPlayer
     return true;
 }
 
-bool RpgTrainTrigger::IsActive()
+bool RpgTrainTrigger::IsActiveFor(RpgCandidate const& candidate)
 {
-    GuidPosition guidP(getGuidP());
-
-    if (!guidP.HasNpcFlag(UNIT_NPC_FLAG_TRAINER))
+    if (!candidate.HasNpcFlag(UNIT_NPC_FLAG_TRAINER))
         return false;
 
-    CreatureTemplate const* cInfo = guidP.GetCreatureTemplate();
+    CreatureTemplate const* cInfo = candidate.creatureInfo;
 
     if (!IsTrainerOf(cInfo, bot))
         return false;
 
     // check present spell in trainer spell list
-    TrainerSpellData const* cSpells = sObjectMgr->GetNpcTrainerSpells(guidP.GetEntry());
+    TrainerSpellData const* cSpells = sObjectMgr->GetNpcTrainerSpells(candidate.guidP.GetEntry());
     if (!cSpells)
     {
         return false;
@@ -254,12 +269,12 @@ bool RpgTrainTrigger::IsActive()
     return false;
 }
 
-bool RpgHealTrigger::IsActive()
+bool RpgHealTrigger::IsActiveFor(RpgCandidate const& candidate)
 {
     if (!botAI->HasStrategy("heal", BOT_STATE_COMBAT))
         return false;
 
-    GuidPosition guidP(getGuidP());
+    GuidPosition guidP(candidate.guidP);
 
     Unit* unit = guidP.GetUnit();
 
@@ -275,11 +290,9 @@ bool RpgHealTrigger::IsActive()
     return true;
 }
 
-bool RpgHomeBindTrigger::IsActive()
+bool RpgHomeBindTrigger::IsActiveFor(RpgCandidate const& candidate)
 {
-    GuidPosition guidP(getGuidP());
-
-    if (!guidP.HasNpcFlag(UNIT_NPC_FLAG_INNKEEPER))
+    if (!candidate.HasNpcFlag(UNIT_NPC_FLAG_INNKEEPER))
         return false;
 
     if (AI_VALUE(WorldPosition, "home bind").distance(bot) < 500.0f)
@@ -288,15 +301,13 @@ bool RpgHomeBindTrigger::IsActive()
     return true;
 }
 
-bool RpgQueueBGTrigger::IsActive()
+bool RpgQueueBGTrigger::IsActiveFor(RpgCandidate const& candidate)
 {
     // skip bots not in continents
     if (!WorldPosition(bot).isOverworld())  // bg, raid, dungeon
         return false;
 
-    GuidPosition guidP(getGuidP());
-
-    if (!guidP.IsCreature())
+    if (!candidate.guidP.IsCreature())
         return false;
 
     // if bot is not leader disallow tag bg
@@ -309,11 +320,9 @@ bool RpgQueueBGTrigger::IsActive()
     return true;
 }
 
-bool RpgBuyPetitionTrigger::IsActive()
+bool RpgBuyPetitionTrigger::IsActiveFor(RpgCandidate const& candidate)
 {
-    GuidPosition guidP(getGuidP());
-
-    if (!guidP.HasNpcFlag(UNIT_NPC_FLAG_PETITIONER))
+    if (!candidate.HasNpcFlag(UNIT_NPC_FLAG_PETITIONER))
         return false;
 
     if (!BuyPetitionAction::canBuyPetition(bot))
@@ -322,15 +331,12 @@ bool RpgBuyPetitionTrigger::IsActive()
     return true;
 }
 
-bool RpgUseTrigger::IsActive()
+bool RpgUseTrigger::IsActiveFor(RpgCandidate const& candidate)
 {
-    GuidPosition guidP(getGuidP());
-
-    if (!guidP.IsGameObject())
+    GameObjectTemplate const* goInfo = candidate.goInfo;
+    if (!goInfo)
         return false;
 
-    GameObjectTemplate const* goInfo = guidP.GetGameObjectTemplate();
-
     switch (goInfo->type)
     {
         case GAMEOBJECT_TYPE_BINDER:
@@ -356,9 +362,9 @@ bool RpgUseTrigger::IsActive()
     return true;
 }
 
-bool RpgSpellTrigger::IsActive()
+bool RpgSpellTrigger::IsActiveFor(RpgCandidate const& candidate)
 {
-    GuidPosition guidP(getGuidP());
+    GuidPosition guidP(candidate.guidP);
 
     if (guidP.IsPlayer())
         return false;
@@ -369,9 +375,9 @@ bool RpgSpellTrigger::IsActive()
     return true;
 }
 
-bool RpgCraftTrigger::IsActive()
+bool RpgCraftTrigger::IsActiveFor(RpgCandidate const& candidate)
 {
-    GuidPosition guidP(getGuidP());
+    GuidPosition guidP(candidate.guidP);
 
     if (guidP.IsPlayer())
         return false;
@@ -382,9 +388,9 @@ bool RpgCraftTrigger::IsActive()
     return true;
 }
 
-bool RpgTradeUsefulTrigger::IsActive()
+bool RpgTradeUsefulTrigger::IsActiveFor(RpgCandidate const& candidate)
 {
-    GuidPosition guidP(getGuidP());
+    GuidPosition guidP(candidate.guidP);
 
     if (!guidP.IsPlayer())
         return false;
@@ -422,7 +428,7 @@ bool RpgTradeUsefulTrigger::IsActive()
     return true;
 }
 
-bool RpgDuelTrigger::IsActive()
+bool RpgDuelTrigger::IsActiveFor(RpgCandidate const& candidate)
 {
     if (!botAI->HasStrategy("start duel", BOT_STATE_NON_COMBAT))
         return false;
@@ -442,7 +448,7 @@ bool RpgDuelTrigger::IsActive()
     if (AI_VALUE2(uint8, "health", "self target") < 90)
         return false;
 
-    GuidPosition guidP(getGuidP());
+    GuidPosition guidP(candidate.guidP);
 
     if (!guidP.IsPlayer())
         return false;
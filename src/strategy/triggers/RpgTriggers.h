@@ -6,14 +6,38 @@
 #ifndef _PLAYERBOT_RPGTRIGGERS_H
 #define _PLAYERBOT_RPGTRIGGERS_H
 
+#include <optional>
+
+#include "TravelMgr.h"
 #include "Trigger.h"
 
 class Event;
-class GuidPosition;
 class PlayerbotAI;
 
 struct CreatureTemplate;
 
+// What the rpg sub triggers look at on a possible rpg target, the expensive parts only once a trigger asks for them
+struct RpgCandidate
+{
+    RpgCandidate(PlayerbotAI* botAI, GuidPosition const& guidP);
+
+    bool HasNpcFlag(NPCFlags flag) const { return npcFlags & flag; }
+    // quest dialog status of quest givers, DIALOG_STATUS_NONE for everyone else
+    uint32 GetDialogStatus() const;
+    // nearest taxi node of flight masters
+    uint32 GetTaxiNode() const;
+
+    GuidPosition guidP;
+    CreatureTemplate const* creatureInfo = nullptr;
+    GameObjectTemplate const* goInfo = nullptr;
+    uint32 npcFlags = 0;
+
+private:
+    PlayerbotAI* botAI;
+    mutable std::optional<uint32> dialogStatus;
+    mutable std::optional<uint32> taxiNode;
+};
+
 class NoRpgTargetTrigger : public Trigger
 {
 public:
@@ -71,6 +95,8 @@ public:
 
     bool IsActive() override;
     Event Check() override;
+    // side effect free, ChooseRpgTargetAction ranks possible targets with it without making them the rpg target
+    virtual bool IsActiveFor(RpgCandidate const& /*candidate*/) { return true; }
 };
 
 class RpgTaxiTrigger : public RpgTrigger
@@ -78,7 +104,7 @@ class RpgTaxiTrigger : public RpgTrigger
 public:
     RpgTaxiTrigger(PlayerbotAI* botAI, std::string const name = "rpg taxi") : RpgTrigger(botAI, name) {}
 
-    bool IsActive() override;
+    bool IsActiveFor(RpgCandidate const& candidate) override;
 };
 
 class RpgDiscoverTrigger : public RpgTrigger
@@ -86,7 +112,7 @@ class RpgDiscoverTrigger : public RpgTrigger
 public:
     RpgDiscoverTrigger(PlayerbotAI* botAI, std::string const name = "rpg discover") : RpgTrigger(botAI, name) {}
 
-    bool IsActive() override;
+    bool IsActiveFor(RpgCandidate const& candidate) override;
 };
 
 class RpgStartQuestTrigger : public RpgTrigger
@@ -94,7 +120,7 @@ class RpgStartQuestTrigger : public RpgTrigger
 public:
     RpgStartQuestTrigger(PlayerbotAI* botAI, std::string const name = "rpg start quest") : RpgTrigger(botAI, name) {}
 
-    bool IsActive() override;
+    bool IsActiveFor(RpgCandidate const& candidate) override;
 };
 
 class RpgEndQuestTrigger : public RpgTrigger
@@ -102,7 +128,7 @@ class RpgEndQuestTrigger : public RpgTrigger
 public:
     RpgEndQuestTrigger(PlayerbotAI* botAI, std::string const name = "rpg end quest") : RpgTrigger(botAI, name) {}
 
-    bool IsActive() override;
+    bool IsActiveFor(RpgCandidate const& candidate) override;
 };
 
 class RpgBuyTrigger : public RpgTrigger
@@ -110,7 +136,7 @@ class RpgBuyTrigger : public RpgTrigger
 public:
     RpgBuyTrigger(PlayerbotAI* botAI, std::string const name = "rpg buy") : RpgTrigger(botAI, name) {}
 
-    bool IsActive() override;
+    bool IsActiveFor(RpgCandidate const& candidate) override;
 };
 
 class RpgSellTrigger : public RpgTrigger
@@ -118,7 +144,7 @@ class RpgSellTrigger : public RpgTrigger
 public:
     RpgSellTrigger(PlayerbotAI* botAI, std::string const name = "rpg sell") : RpgTrigger(botAI, name) {}
 
-    bool IsActive() override;
+    bool IsActiveFor(RpgCandidate const& candidate) override;
 };
 
 class RpgRepairTrigger : public RpgTrigger
@@ -126,7 +152,7 @@ class RpgRepairTrigger : public RpgTrigger
 public:
     RpgRepairTrigger(PlayerbotAI* botAI, std::string const name = "rpg repair") : RpgTrigger(botAI, name) {}
 
-    bool IsActive() override;
+    bool IsActiveFor(RpgCandidate const& candidate) override;
 };
 
 class RpgTrainTrigger : public RpgTrigger
@@ -136,7 +162,7 @@ public:
 
     static bool IsTrainerOf(CreatureTemplate const* cInfo, Player* pPlayer);
 
-    bool IsActive() override;
+    bool IsActiveFor(RpgCandidate const& candidate) override;
 };
 
 class RpgHealTrigger : public RpgTrigger
@@ -144,7 +170,7 @@ class RpgHealTrigger : public RpgTrigger
 public:
     RpgHealTrigger(PlayerbotAI* botAI, std::string const name = "rpg heal") : RpgTrigger(botAI, name) {}
 
-    bool IsActive() override;
+    bool IsActiveFor(RpgCandidate const& candidate) override;
 };
 
 class RpgHomeBindTrigger : public RpgTrigger
@@ -152,7 +178,7 @@ class RpgHomeBindTrigger : public RpgTrigger
 public:
     RpgHomeBindTrigger(PlayerbotAI* botAI, std::string const name = "rpg home bind") : RpgTrigger(botAI, name) {}
 
-    bool IsActive() override;
+    bool IsActiveFor(RpgCandidate const& candidate) override;
 };
 
 class RpgQueueBGTrigger : public RpgTrigger
@@ -160,7 +186,7 @@ class RpgQueueBGTrigger : public RpgTrigger
 public:
     RpgQueueBGTrigger(PlayerbotAI* botAI, std::string const name = "rpg queue bg") : RpgTrigger(botAI, name) {}
 
-    bool IsActive() override;
+    bool IsActiveFor(RpgCandidate const& candidate) override;
 };
 
 class RpgBuyPetitionTrigger : public RpgTrigger
@@ -168,7 +194,7 @@ class RpgBuyPetitionTrigger : public RpgTrigger
 public:
     RpgBuyPetitionTrigger(PlayerbotAI* botAI, std::string const name = "rpg buy petition") : RpgTrigger(botAI, name) {}
 
-    bool IsActive() override;
+    bool IsActiveFor(RpgCandidate const& candidate) override;
 };
 
 class RpgUseTrigger : public RpgTrigger
@@ -176,7 +202,7 @@ class RpgUseTrigger : public RpgTrigger
 public:
     RpgUseTrigger(PlayerbotAI* botAI, std::string const name = "rpg use") : RpgTrigger(botAI, name) {}
 
-    bool IsActive() override;
+    bool IsActiveFor(RpgCandidate const& candidate) override;
 };
 
 class RpgSpellTrigger : public RpgTrigger
@@ -184,7 +210,7 @@ class RpgSpellTrigger : public RpgTrigger
 public:
     RpgSpellTrigger(PlayerbotAI* botAI, std::string const name = "rpg spell") : RpgTrigger(botAI, name) {}
 
-    bool IsActive() override;
+    bool IsActiveFor(RpgCandidate const& candidate) override;
 };
 
 class RpgCraftTrigger : public RpgTrigger
@@ -192,7 +218,7 @@ class RpgCraftTrigger : public RpgTrigger
 public:
     RpgCraftTrigger(PlayerbotAI* botAI, std::string const name = "rpg craft") : RpgTrigger(botAI, name) {}
 
-    bool IsActive() override;
+    bool IsActiveFor(RpgCandidate const& candidate) override;
 };
 
 class RpgTradeUsefulTrigger : public RpgTrigger
@@ -200,7 +226,7 @@ class RpgTradeUsefulTrigger : public RpgTrigger
 public:
     RpgTradeUsefulTrigger(PlayerbotAI* botAI, std::string const name = "rpg trade useful") : RpgTrigger(botAI, name) {}
 
-    bool IsActive() override;
+    bool IsActiveFor(RpgCandidate const& candidate) override;
 };
 
 class RpgDuelTrigger : public RpgTrigger
@@ -208,7 +234,7 @@ class RpgDuelTrigger : public RpgTrigger
 public:
     RpgDuelTrigger(PlayerbotAI* botAI, std::string const name = "rpg duel") : RpgTrigger(botAI, name) {}
 
-    bool IsActive() override;
+    bool IsActiveFor(RpgCandidate const& candidate) override;
 };
 
 #endif
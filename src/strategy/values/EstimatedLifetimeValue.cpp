@@ -6,6 +6,74 @@
 #include "PlayerbotFactory.h"
 #include "Playerbots.h"
 #include "SharedDefines.h"
+#include "Timer.h"
+
+// matches the check interval of the group dps value
+static constexpr uint32 GROUP_DPS_EXPIRE = 20 * IN_MILLISECONDS;
+static constexpr uint32 LIFETIME_EXPIRE = 1 * IN_MILLISECONDS;
+static constexpr uint32 LIFETIME_CLEANUP = 10 * IN_MILLISECONDS;
+
+bool GroupDpsBoard::GetGroupDps(uint32 now, float& dps) const
+{
+    if (!hasGroupDps || getMSTimeDiff(groupDps.at, now) > GROUP_DPS_EXPIRE)
+        return false;
+
+    dps = groupDps.value;
+    return true;
+}
+
+void GroupDpsBoard::SetGroupDps(float dps, uint32 now)
+{
+    groupDps.value = dps;
+    groupDps.at = now;
+    hasGroupDps = true;
+}
+
+bool GroupDpsBoard::GetLifetime(ObjectGuid target, uint32 now, float& lifetime) const
+{
+    auto estimate = lifetimes.find(target);
+    if (estimate == lifetimes.end() || getMSTimeDiff(estimate->second.at, now) > LIFETIME_EXPIRE)
+        return false;
+
+    lifetime = estimate->second.value;
+    return true;
+}
+
+void GroupDpsBoard::SetLifetime(ObjectGuid target, float lifetime, uint32 now)
+{
+    if (getMSTimeDiff(lastCleanup, now) > LIFETIME_CLEANUP)
+    {
+        lastCleanup = now;
+        for (auto it = lifetimes.begin(); it != lifetimes.end();)
+        {
+            if (getMSTimeDiff(it->second.at, now) > LIFETIME_EXPIRE)
+                it = lifetimes.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    Estimate& estimate = lifetimes[target];
+    estimate.value = lifetime;
+    estimate.at = now;
+}
+
+GroupDpsBoard* GroupDpsBoardRef::Get(Player* bot, uint32 now)
+{
+    Group* botGroup = bot->GetGroup();
+    uint64 const groupGuid = botGroup ? botGroup->GetGUID().GetRawValue() : 0;
+    if (groupGuid != group || bot->GetMapId() != mapId || bot->GetInstanceId() != instanceId ||
+        getMSTimeDiff(fetchedAt, now) > GROUP_DPS_EXPIRE)
+    {
+        board = sGroupDpsBoardMgr->GetBoard(bot);
+        group = groupGuid;
+        mapId = bot->GetMapId();
+        instanceId = bot->GetInstanceId();
+        fetchedAt = now;
+    }
+
+    return board.get();
+}
 
 float EstimatedLifetimeValue::Calculate()
 {
@@ -14,16 +82,42 @@ float EstimatedLifetimeValue::Calculate()
     {
         return 0.0f;
     }
+
+    uint32 const now = getMSTime();
+    GroupDpsBoard* groupBoard = board.Get(bot, now);
+    float res;
+    if (groupBoard && groupBoard->GetLifetime(target->GetGUID(), now, res))
+        return res;
+
     float dps = AI_VALUE(float, "estimated group dps");
     bool aoePenalty = AI_VALUE(uint8, "attacker count") >= 3;
     if (aoePenalty)
         dps *= 0.75;
-    float res = target->GetHealth() / dps;
+    res = target->GetHealth() / dps;
     // bot->Say(target->GetName() + " lifetime: " + std::to_string(res), LANG_UNIVERSAL);
+
+    if (groupBoard)
+        groupBoard->SetLifetime(target->GetGUID(), res, now);
+
     return res;
 }
 
 float EstimatedGroupDpsValue::Calculate()
+{
+    uint32 const now = getMSTime();
+    GroupDpsBoard* groupBoard = board.Get(bot, now);
+    float totalDps;
+    if (groupBoard && groupBoard->GetGroupDps(now, totalDps))
+        return totalDps;
+
+    totalDps = CalculateGroupDps();
+    if (groupBoard)
+        groupBoard->SetGroupDps(totalDps, now);
+
+    return totalDps;
+}
+
+float EstimatedGroupDpsValue::CalculateGroupDps()
 {
     float totalDps = 0;
 
@@ -37,7 +131,8 @@ float EstimatedGroupDpsValue::Calculate()
                 continue;
 
             // ignore real player as they may not help with damage
-            if (!GET_PLAYERBOT_AI(member) || GET_PLAYERBOT_AI(member)->IsRealPlayer())
+            PlayerbotAI* memberAI = GET_PLAYERBOT_AI(member);
+            if (!memberAI || memberAI->IsRealPlayer())
                 continue;
 
             if (!member || !member->IsInWorld() || !member->IsAlive())
@@ -6,7 +6,11 @@
 #ifndef _PLAYERBOT_EstimatedLifetimeValue_H
 #define _PLAYERBOT_EstimatedLifetimeValue_H
 
+#include <unordered_map>
+
+#include "GroupBoardMgr.h"
 #include "NamedObjectContext.h"
+#include "ObjectGuid.h"
 #include "PossibleTargetsValue.h"
 #include "TargetValue.h"
 #include "Value.h"
@@ -14,6 +18,53 @@
 class PlayerbotAI;
 class Unit;
 
+/**
+ * @brief Group dps estimate and target lifetimes of one group on one map instance
+ *
+ * The first bot of the group to need a value computes it, the other members read it until it expires, so a raid
+ * walks its members' gear once per interval instead of once per bot. Lifetimes expire quickly as target health moves.
+ */
+class GroupDpsBoard
+{
+public:
+    bool GetGroupDps(uint32 now, float& dps) const;
+    void SetGroupDps(float dps, uint32 now);
+
+    bool GetLifetime(ObjectGuid target, uint32 now, float& lifetime) const;
+    void SetLifetime(ObjectGuid target, float lifetime, uint32 now);
+
+private:
+    struct Estimate
+    {
+        float value = 0.0f;
+        uint32 at = 0;
+    };
+
+    Estimate groupDps;
+    bool hasGroupDps = false;
+    std::unordered_map<ObjectGuid, Estimate> lifetimes;
+    uint32 lastCleanup = 0;
+};
+
+typedef GroupBoardMgr<GroupDpsBoard> GroupDpsBoardMgr;
+
+#define sGroupDpsBoardMgr GroupDpsBoardMgr::instance()
+
+// The bot's board kept by a value, looked up in the manager again only when the group, map or instance changed or the
+// group dps expired, which also keeps the manager from dropping a board still in use
+class GroupDpsBoardRef
+{
+public:
+    GroupDpsBoard* Get(Player* bot, uint32 now);
+
+private:
+    std::shared_ptr<GroupDpsBoard> board;
+    uint64 group = 0;
+    uint32 mapId = 0;
+    uint32 instanceId = 0;
+    uint32 fetchedAt = 0;
+};
+
 // [target health] / [expected group single target dps] = [expected lifetime]
 class EstimatedLifetimeValue : public FloatCalculatedValue, public Qualified
 {
@@ -22,6 +73,9 @@ public:
 
 public:
     float Calculate() override;
+
+private:
+    GroupDpsBoardRef board;
 };
 
 class EstimatedGroupDpsValue : public FloatCalculatedValue
@@ -33,8 +87,12 @@ public:
     float Calculate() override;
 
 protected:
+    float CalculateGroupDps();
     float GetBasicDps(uint32 level);
     float GetBasicGs(uint32 level);
+
+private:
+    GroupDpsBoardRef board;
 };
 
 #endif
@@ -5,32 +5,51 @@
 
 #include "GrindTargetValue.h"
 
+#include <algorithm>
+
 #include "NewRpgInfo.h"
 #include "Playerbots.h"
 #include "ReputationMgr.h"
 #include "ServerFacade.h"
 #include "SharedDefines.h"
 
-Unit* GrindTargetValue::Calculate()
-{
-    uint32 memberCount = 1;
-    Group* group = bot->GetGroup();
-    if (group)
-        memberCount = group->GetMembersCount();
+// claims are republished on every calculation, a bot that stopped grinding drops out after a few seconds
+static constexpr uint32 GRIND_CLAIM_EXPIRE = 5 * IN_MILLISECONDS;
 
-    Unit* target = nullptr;
-    uint32 assistCount = 0;
-    while (!target && assistCount < memberCount)
+void GrindClaimBoard::Claim(ObjectGuid member, ObjectGuid target, uint32 now)
+{
+    if (target.IsEmpty())
     {
-        target = FindTargetForGrinding(assistCount++);
+        claims.erase(member);
+        return;
     }
 
+    GrindClaim& claim = claims[member];
+    claim.target = target;
+    claim.claimedAt = now;
+}
+
+ObjectGuid GrindClaimBoard::GetClaim(ObjectGuid member, uint32 now) const
+{
+    auto claim = claims.find(member);
+    if (claim == claims.end() || getMSTimeDiff(claim->second.claimedAt, now) > GRIND_CLAIM_EXPIRE)
+        return ObjectGuid::Empty;
+
+    return claim->second.target;
+}
+
+Unit* GrindTargetValue::Calculate()
+{
+    Unit* target = FindTargetForGrinding();
+
+    if (std::shared_ptr<GrindClaimBoard> board = sGrindClaimBoardMgr->GetBoard(bot))
+        board->Claim(bot->GetGUID(), target ? target->GetGUID() : ObjectGuid::Empty, getMSTime());
+
     return target;
 }
 
-Unit* GrindTargetValue::FindTargetForGrinding(uint32 assistCount)
+Unit* GrindTargetValue::FindTargetForGrinding()
 {
-    uint32 memberCount = 1;
     Group* group = bot->GetGroup();
     Player* master = GetMaster();
 
@@ -52,9 +71,26 @@ Unit* GrindTargetValue::FindTargetForGrinding(uint32 assistCount)
     if (targets.empty())
         return nullptr;
 
-    float distance = 0;
-    Unit* result = nullptr;
-    std::unordered_map<uint32, bool> needForQuestMap;
+    // the distance to a candidate is the one of the nearest member, bots spread over targets other members go for
+    std::vector<Player*> members;
+    std::unordered_map<ObjectGuid, uint32> targetingCount;
+    if (group)
+        CollectGroupTargets(group, members, targetingCount);
+    else
+        members.push_back(bot);
+
+    struct GrindCandidate
+    {
+        Unit* unit;
+        uint32 targetingCount;
+        float distance;
+    };
+
+    std::vector<GrindCandidate> candidates;
+    candidates.reserve(targets.size());
+    bool const inactiveGrindStatus =
+        botAI->rpgInfo.status != RPG_WANDER_RANDOM && botAI->rpgInfo.status != RPG_IDLE;
+    bool const canFightElite = AI_VALUE(bool, "can fight elite");
 
     for (ObjectGuid const guid : targets)
     {
@@ -63,7 +99,6 @@ Unit* GrindTargetValue::FindTargetForGrinding(uint32 assistCount)
         if (!unit)
             continue;
 
-        auto& rep = bot->ToPlayer()->GetReputationMgr();
         if (unit->ToCreature() && !unit->ToCreature()->GetCreatureTemplate()->lootid &&
             bot->GetReactionTo(unit) >= REP_NEUTRAL)
         {
@@ -83,12 +118,6 @@ Unit* GrindTargetValue::FindTargetForGrinding(uint32 assistCount)
         if (abs(bot->GetPositionZ() - unit->GetPositionZ()) > INTERACTION_DISTANCE)
             continue;
 
-        if (!bot->InBattleground() && GetTargetingPlayerCount(unit) > assistCount)
-            continue;
-
-        // if (!bot->InBattleground() && master && master->GetDistance(unit) >= sPlayerbotAIConfig->grindDistance &&
-        // !sRandomPlayerbotMgr->IsRandomBot(bot)) continue;
-
         // Bots in bot-groups no have a more limited range to look for grind target
         if (!bot->InBattleground() && master && botAI->HasStrategy("follow", BotState::BOT_STATE_NON_COMBAT) &&
             sServerFacade->GetDistance2d(master, unit) > sPlayerbotAIConfig->lootDistance)
@@ -103,131 +132,88 @@ Unit* GrindTargetValue::FindTargetForGrinding(uint32 assistCount)
 
         if (Creature* creature = unit->ToCreature())
             if (CreatureTemplate const* CreatureTemplate = creature->GetCreatureTemplate())
-                if (CreatureTemplate->rank > CREATURE_ELITE_NORMAL && !AI_VALUE(bool, "can fight elite"))
+                if (CreatureTemplate->rank > CREATURE_ELITE_NORMAL && !canFightElite)
                     continue;
 
-        if (!bot->IsWithinLOSInMap(unit))
-        {
-            continue;
-        }
-
-        bool inactiveGrindStatus = botAI->rpgInfo.status != RPG_WANDER_RANDOM && botAI->rpgInfo.status != RPG_IDLE;
-
         float aggroRange = 30.0f;
         if (unit->ToCreature())
             aggroRange = std::min(30.0f, unit->ToCreature()->GetAggroRange(bot) + 10.0f);
         bool outOfAggro = unit->ToCreature() && bot->GetDistance(unit) > aggroRange;
-        if (inactiveGrindStatus && outOfAggro)
-        {
-            if (needForQuestMap.find(unit->GetEntry()) == needForQuestMap.end())
-                needForQuestMap[unit->GetEntry()] = needForQuest(unit);
-
-            if (!needForQuestMap[unit->GetEntry()])
-                continue;
-        }
+        if (inactiveGrindStatus && outOfAggro && !needForQuest(unit))
+            continue;
 
-        if (group)
+        float distance = 0.0f;
+        for (uint32 i = 0; i < members.size(); ++i)
         {
-            Group::MemberSlotList const& groupSlot = group->GetMemberSlots();
-            for (Group::member_citerator itr = groupSlot.begin(); itr != groupSlot.end(); itr++)
-            {
-                Player* member = ObjectAccessor::FindPlayer(itr->guid);
-                if (!member || !member->IsAlive())
-                    continue;
-
-                float d = member->GetDistance(unit);
-                if (!result || d < distance)
-                {
-                    distance = d;
-                    result = unit;
-                }
-            }
+            float d = members[i]->GetDistance(unit);
+            if (!i || d < distance)
+                distance = d;
         }
-        else
+
+        uint32 count = 0;
+        if (!bot->InBattleground())
         {
-            float newdistance = bot->GetDistance(unit);
-            if (!result || (newdistance < distance))
-            {
-                distance = newdistance;
-                result = unit;
-            }
+            auto targeting = targetingCount.find(unit->GetGUID());
+            if (targeting != targetingCount.end())
+                count = targeting->second;
         }
-    }
-
-    return result;
-}
-
-bool GrindTargetValue::needForQuest(Unit* target)
-{
-    QuestStatusMap& questMap = bot->getQuestStatusMap();
-    for (auto& quest : questMap)
-    {
-        Quest const* questTemplate = sObjectMgr->GetQuestTemplate(quest.first);
-        if (!questTemplate)
-            continue;
-
-        uint32 questId = questTemplate->GetQuestId();
-        if (!questId)
-            continue;
 
-        QuestStatus status = bot->GetQuestStatus(questId);
+        candidates.push_back({unit, count, distance});
+    }
 
-        if (status == QUEST_STATUS_INCOMPLETE)
-        {
-            const QuestStatusData* questStatus = &bot->getQuestStatusMap()[questId];
+    // targets fewer members go for first, then the nearest, so only the line of sight of the winner is usually checked
+    std::sort(candidates.begin(), candidates.end(),
+              [](GrindCandidate const& lhs, GrindCandidate const& rhs)
+              {
+                  if (lhs.targetingCount != rhs.targetingCount)
+                      return lhs.targetingCount < rhs.targetingCount;
 
-            if (questTemplate->GetQuestLevel() > bot->GetLevel() + 5)
-                continue;
+                  return lhs.distance < rhs.distance;
+              });
 
-            for (int j = 0; j < QUEST_OBJECTIVES_COUNT; j++)
-            {
-                int32 entry = questTemplate->RequiredNpcOrGo[j];
+    for (GrindCandidate const& candidate : candidates)
+    {
+        if (bot->IsWithinLOSInMap(candidate.unit))
+            return candidate.unit;
+    }
 
-                if (entry && entry > 0)
-                {
-                    int required = questTemplate->RequiredNpcOrGoCount[j];
-                    int available = questStatus->CreatureOrGOCount[j];
+    return nullptr;
+}
 
-                    if (required && available < required && target->GetEntry() == entry)
-                        return true;
-                }
-            }
-        }
-    }
+bool GrindTargetValue::needForQuest(Unit* target)
+{
+    PlayerbotQuestIndex& questIndex = botAI->GetQuestIndex();
+    if (questIndex.NeedsNpcOrGo(target->GetEntry(), bot->GetLevel() + 5))
+        return true;
 
     if (CreatureTemplate const* data = sObjectMgr->GetCreatureTemplate(target->GetEntry()))
     {
         if (uint32 lootId = data->lootid)
-        {
-            if (LootTemplates_Creature.HaveQuestLootForPlayer(lootId, bot))
-            {
-                return true;
-            }
-        }
+            return questIndex.HasQuestLoot(lootId, bot);
     }
 
     return false;
 }
 
-uint32 GrindTargetValue::GetTargetingPlayerCount(Unit* unit)
+void GrindTargetValue::CollectGroupTargets(Group* group, std::vector<Player*>& members,
+                                           std::unordered_map<ObjectGuid, uint32>& targetingCount)
 {
-    Group* group = bot->GetGroup();
-    if (!group)
-        return 0;
+    std::shared_ptr<GrindClaimBoard> board = sGrindClaimBoardMgr->GetBoard(bot);
+    uint32 const now = getMSTime();
 
-    uint32 count = 0;
-    Group::MemberSlotList const& groupSlot = group->GetMemberSlots();
-    for (Group::member_citerator itr = groupSlot.begin(); itr != groupSlot.end(); itr++)
+    for (GroupReference* ref = group->GetFirstMember(); ref; ref = ref->next())
     {
-        Player* member = ObjectAccessor::FindPlayer(itr->guid);
-        if (!member || !member->IsAlive() || member == bot)
+        Player* member = ref->GetSource();
+        if (!member || !member->IsAlive() || !member->IsInMap(bot))
             continue;
 
-        PlayerbotAI* botAI = GET_PLAYERBOT_AI(member);
-        if ((botAI && *botAI->GetAiObjectContext()->GetValue<Unit*>("current target") == unit) ||
-            (!botAI && member->GetTarget() == unit->GetGUID()))
-            ++count;
-    }
+        members.push_back(member);
+        if (member == bot)
+            continue;
 
-    return count;
+        // bots publish their grind target on the board, real players only have their selection
+        ObjectGuid target = GET_PLAYERBOT_AI(member) ? board->GetClaim(member->GetGUID(), now) : member->GetTarget();
+        if (!target.IsEmpty())
+            ++targetingCount[target];
+    }
 }
@@ -6,11 +6,39 @@
 #ifndef _PLAYERBOT_GRINDTARGETVALUE_H
 #define _PLAYERBOT_GRINDTARGETVALUE_H
 
+#include <unordered_map>
+#include <vector>
+
+#include "GroupBoardMgr.h"
+#include "ObjectGuid.h"
 #include "TargetValue.h"
 
 class PlayerbotAI;
 class Unit;
 
+// Grind targets picked by the bots of one group on one map instance, read instead of every bot's current target
+class GrindClaimBoard
+{
+public:
+    // an empty target drops the member's claim
+    void Claim(ObjectGuid member, ObjectGuid target, uint32 now);
+    // target the member picked within the last few seconds
+    ObjectGuid GetClaim(ObjectGuid member, uint32 now) const;
+
+private:
+    struct GrindClaim
+    {
+        ObjectGuid target;
+        uint32 claimedAt = 0;
+    };
+
+    std::unordered_map<ObjectGuid, GrindClaim> claims;
+};
+
+typedef GroupBoardMgr<GrindClaimBoard> GrindClaimBoardMgr;
+
+#define sGrindClaimBoardMgr GrindClaimBoardMgr::instance()
+
 class GrindTargetValue : public TargetValue
 {
 public:
@@ -19,8 +47,9 @@ public:
     Unit* Calculate() override;
 
 private:
-    uint32 GetTargetingPlayerCount(Unit* unit);
-    Unit* FindTargetForGrinding(uint32 assistCount);
+    void CollectGroupTargets(Group* group, std::vector<Player*>& members,
+                             std::unordered_map<ObjectGuid, uint32>& targetingCount);
+    Unit* FindTargetForGrinding();
     bool needForQuest(Unit* target);
 };
 
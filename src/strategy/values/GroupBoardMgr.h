@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_GROUPBOARDMGR_H
+#define _PLAYERBOT_GROUPBOARDMGR_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+#include "Group.h"
+#include "Player.h"
+#include "Timer.h"
+
+/**
+ * @brief State shared by the bots of one group on one map instance
+ *
+ * Keyed by map instance so a board is only used by the thread updating that map, the boards themselves need no lock.
+ * Boards nobody asked for during a minute are dropped.
+ */
+template <class Board>
+class GroupBoardMgr
+{
+public:
+    static GroupBoardMgr* instance()
+    {
+        static GroupBoardMgr instance;
+        return &instance;
+    }
+
+    // board of the bot's group on the bot's map instance, nullptr without group
+    std::shared_ptr<Board> GetBoard(Player* bot)
+    {
+        Group* group = bot->GetGroup();
+        if (!group)
+            return nullptr;
+
+        BoardKey const key(group->GetGUID().GetRawValue(), bot->GetMapId(), bot->GetInstanceId());
+        uint32 const now = getMSTime();
+
+        // boards are shared by pointer, a board dropped here is freed once its map thread let go of it
+        std::lock_guard<std::mutex> guard(lock);
+        if (getMSTimeDiff(lastCleanup, now) > BOARD_EXPIRE)
+        {
+            lastCleanup = now;
+            for (auto it = boards.begin(); it != boards.end();)
+            {
+                if (getMSTimeDiff(it->second.lastUsed, now) > BOARD_EXPIRE)
+                    it = boards.erase(it);
+                else
+                    ++it;
+            }
+        }
+
+        BoardSlot& slot = boards[key];
+        if (!slot.board)
+            slot.board = std::make_shared<Board>();
+
+        slot.lastUsed = now;
+        return slot.board;
+    }
+
+private:
+    static constexpr uint32 BOARD_EXPIRE = 60 * IN_MILLISECONDS;
+
+    // group, map, instance
+    typedef std::tuple<uint64, uint32, uint32> BoardKey;
+
+    struct BoardSlot
+    {
+        std::shared_ptr<Board> board;
+        uint32 lastUsed = 0;
+    };
+
+    std::mutex lock;
+    std::map<BoardKey, BoardSlot> boards;
+    uint32 lastCleanup = 0;
+};
+
+#endif
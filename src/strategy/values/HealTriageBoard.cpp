@@ -0,0 +1,398 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "HealTriageBoard.h"
+
+#include <algorithm>
+
+#include "AnticipatoryThreatValue.h"
+#include "Playerbots.h"
+#include "Spell.h"
+#include "SpellAuraEffects.h"
+#include "Timer.h"
+
+namespace
+{
+    constexpr uint32 HEAL_TRIAGE_REFRESH = 100;
+    // about one heal cast, long enough for the healer's spell to show up as a cast in flight
+    constexpr uint32 HEAL_TRIAGE_CLAIM = 1500;
+    constexpr uint32 HEAL_TRIAGE_EXPIRE = 30000;
+
+    bool IsHealingSpell(SpellInfo const* spellInfo)
+    {
+        for (uint8 i = 0; i < 3; ++i)
+        {
+            if (spellInfo->Effects[i].Effect == SPELL_EFFECT_HEAL ||
+                spellInfo->Effects[i].Effect == SPELL_EFFECT_HEAL_MAX_HEALTH ||
+                spellInfo->Effects[i].Effect == SPELL_EFFECT_HEAL_MECHANICAL)
+                return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * Get role priority bonus (subtracted from score)
+     * Tank = -20, Healer = -10, DPS = 0
+     */
+    float GetRolePriorityBonus(Unit* unit)
+    {
+        // Check if it's a player
+        Player* player = unit->ToPlayer();
+        if (!player)
+            return 0.0f;  // Non-players (pets) get no role bonus
+
+        // Tank: highest priority (-20)
+        if (PlayerbotAI::IsTank(player))
+            return -20.0f;
+
+        // Healer: second priority (-10) - keeping healers alive is critical
+        if (PlayerbotAI::IsHeal(player))
+            return -10.0f;
+
+        // DPS: baseline (0)
+        return 0.0f;
+    }
+
+    /**
+     * Get incoming damage for a unit from AnticipatoryThreat system
+     */
+    uint32 GetIncomingDamage(Unit* unit)
+    {
+        // Use the AnticipatoryThreat system to get incoming damage
+        uint32 totalDamage = 0;
+
+        // Check for active casts targeting this unit
+        for (auto& ref : unit->getHostileRefMgr())
+        {
+            Unit* enemy = ref.GetSource()->GetOwner();
+            if (!enemy || !enemy->IsAlive())
+                continue;
+
+            // Check current spell
+            Spell* spell = enemy->GetCurrentSpell(CURRENT_GENERIC_SPELL);
+            if (!spell)
+                spell = enemy->GetCurrentSpell(CURRENT_CHANNELED_SPELL);
+
+            if (spell)
+            {
+                ObjectGuid targetGuid = spell->m_targets.GetUnitTargetGUID();
+
+                // Check if targeting this unit or is AOE
+                bool isTargeting = (targetGuid == unit->GetGUID());
+                bool isAoe = spell->GetSpellInfo()->IsAffectingArea();
+
+                if (isTargeting || (isAoe && targetGuid.IsEmpty()))
+                {
+                    // Look up in boss ability database
+                    const BossAbilityData* ability = sAnticipatoryThreat->GetAbilityBySpell(spell->GetSpellInfo()->Id);
+                    if (ability)
+                    {
+                        totalDamage += ability->baseDamage;
+                    }
+                    else
+                    {
+                        // Estimate from spell info
+                        const SpellInfo* info = spell->GetSpellInfo();
+                        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+                        {
+                            if (info->Effects[i].Effect == SPELL_EFFECT_SCHOOL_DAMAGE ||
+                                info->Effects[i].Effect == SPELL_EFFECT_WEAPON_DAMAGE)
+                            {
+                                totalDamage += info->Effects[i].CalcValue(enemy);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // Also consider periodic damage auras
+        Unit::AuraApplicationMap const& auras = unit->GetAppliedAuras();
+        for (auto const& [spellId, auraApp] : auras)
+        {
+            Aura* aura = auraApp->GetBase();
+            if (!aura)
+                continue;
+
+            for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+            {
+                AuraEffect* effect = aura->GetEffect(i);
+                if (!effect)
+                    continue;
+
+                if (effect->GetAuraType() == SPELL_AURA_PERIODIC_DAMAGE ||
+                    effect->GetAuraType() == SPELL_AURA_PERIODIC_LEECH)
+                {
+                    // Consider next 3 seconds of periodic damage
+                    int32 damage = effect->GetAmount();
+                    uint32 amplitude = effect->GetAmplitude();
+                    if (amplitude > 0)
+                    {
+                        uint32 ticksIn3Sec = (3000 / amplitude) + 1;
+                        totalDamage += damage * ticksIn3Sec;
+                    }
+                }
+            }
+        }
+
+        return totalDamage;
+    }
+
+    /**
+     * Get health trend penalty (added to score if health stable, subtracted if dropping fast)
+     */
+    float GetHealthTrendPenalty(Unit* unit, HealthTrendData const& trend)
+    {
+        // Need at least 2 samples for meaningful trend
+        if (trend.sampleCount < 2)
+            return 0.0f;
+
+        // Health change rate is negative when taking damage
+        // Convert to penalty: fast damage intake = negative penalty (priority boost)
+        // healthChangeRate is in HP/second, convert to % of max health
+        float maxHealth = static_cast<float>(unit->GetMaxHealth());
+        if (maxHealth <= 0)
+            return 0.0f;
+
+        float changeRatePct = (trend.healthChangeRate / maxHealth) * 100.0f;
+
+        // Rapid health loss (< -10% per second) = priority boost up to -15
+        // Stable health = no bonus
+        // Health recovering = small penalty (they're being healed already)
+        if (changeRatePct < -20.0f)
+            return -15.0f;  // Very fast damage intake
+        else if (changeRatePct < -10.0f)
+            return -10.0f;  // Fast damage intake
+        else if (changeRatePct < -5.0f)
+            return -5.0f;   // Moderate damage intake
+        else if (changeRatePct > 5.0f)
+            return 5.0f;    // Being healed, lower priority
+        else
+            return 0.0f;    // Stable
+    }
+}
+
+bool HealTriageBoard::IsStale(uint32 now) const
+{
+    return !builtAt || getMSTimeDiff(builtAt, now) >= HEAL_TRIAGE_REFRESH;
+}
+
+void HealTriageBoard::Rebuild(Player* bot, Group* group, uint32 now)
+{
+    builtAt = now;
+    entries.clear();
+
+    Map* map = bot->GetMap();
+    bool isRaid = group->isRaidGroup();
+
+    // heal casts in flight, one pass over the group instead of one per candidate and healer
+    HealCastMap healCasts;
+    for (GroupReference* gref = group->GetFirstMember(); gref; gref = gref->next())
+    {
+        Player* player = gref->GetSource();
+        if (!player || player->GetMap() != map || !player->IsNonMeleeSpellCast(true))
+            continue;
+
+        for (uint8 type = CURRENT_GENERIC_SPELL; type < CURRENT_MAX_SPELL; type++)
+        {
+            Spell* spell = player->GetCurrentSpell((CurrentSpellTypes)type);
+            if (!spell || !IsHealingSpell(spell->m_spellInfo))
+                continue;
+
+            ObjectGuid unitTarget = spell->m_targets.GetUnitTargetGUID();
+            if (!unitTarget)
+                continue;
+
+            std::pair<uint8, ObjectGuid>& casts = healCasts[unitTarget];
+            if (!casts.first)
+                casts.second = player->GetGUID();
+
+            if (casts.first < 255)
+                ++casts.first;
+        }
+    }
+
+    // charmed units never pass the healers' check, so the group's charms are left out
+    for (GroupReference* gref = group->GetFirstMember(); gref; gref = gref->next())
+    {
+        Player* player = gref->GetSource();
+        if (!player || player->GetMap() != map || player->IsGameMaster() || !player->IsAlive())
+            continue;
+
+        AddEntry(player, isRaid, 0.0f, healCasts, now);
+
+        // Pets get lower priority than players (+15 penalty)
+        Pet* pet = player->GetPet();
+        if (pet && pet->IsAlive())
+            AddEntry(pet, isRaid, 15.0f, healCasts, now);
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [](HealTriageEntry const& lhs, HealTriageEntry const& rhs) { return lhs.priority < rhs.priority; });
+
+    // Clean up stale entries (not seen in 30 seconds)
+    if (getMSTimeDiff(lastCleanup, now) > HEAL_TRIAGE_EXPIRE)
+    {
+        lastCleanup = now;
+        for (auto it = trends.begin(); it != trends.end();)
+        {
+            if (getMSTimeDiff(it->second.lastUpdateTime, now) > HEAL_TRIAGE_EXPIRE)
+                it = trends.erase(it);
+            else
+                ++it;
+        }
+
+        for (auto it = claims.begin(); it != claims.end();)
+        {
+            if (it->second.until < now)
+                it = claims.erase(it);
+            else
+                ++it;
+        }
+    }
+}
+
+bool HealTriageBoard::IsBeingHealed(HealTriageEntry const& entry, ObjectGuid healer, uint32 now) const
+{
+    // the healer's own cast does not count
+    if (entry.healCasts > 1 || (entry.healCasts && entry.healCaster != healer))
+        return true;
+
+    auto claim = claims.find(entry.guid);
+    return claim != claims.end() && claim->second.healer != healer && claim->second.until > now;
+}
+
+void HealTriageBoard::Claim(ObjectGuid target, ObjectGuid healer, uint32 now)
+{
+    HealClaim& claim = claims[target];
+
+    // an active claim of another healer stands, the urgent cases overrode it anyway
+    if (claim.healer != healer && claim.until > now)
+        return;
+
+    claim.healer = healer;
+    claim.until = now + HEAL_TRIAGE_CLAIM;
+}
+
+void HealTriageBoard::AddEntry(Unit* unit, bool isRaid, float penalty, HealCastMap const& healCasts, uint32 now)
+{
+    HealthTrendData& trend = trends[unit->GetGUID()];
+    UpdateHealthTrend(unit, trend, now);
+
+    HealTriageEntry entry;
+    entry.guid = unit->GetGUID();
+    entry.priority = CalculateHealPriority(unit, isRaid, trend) + penalty;
+    entry.isPlayer = unit->IsPlayer();
+
+    auto casts = healCasts.find(entry.guid);
+    if (casts != healCasts.end())
+    {
+        entry.healCasts = casts->second.first;
+        entry.healCaster = casts->second.second;
+    }
+
+    entries.push_back(entry);
+}
+
+float HealTriageBoard::CalculateHealPriority(Unit* unit, bool /*isRaid*/, HealthTrendData const& trend)
+{
+    float currentHealth = unit->GetHealthPct();
+    uint32 maxHealth = unit->GetMaxHealth();
+
+    // Base priority is current health percentage
+    float priority = currentHealth;
+
+    // =========================================================================
+    // Factor 1: Incoming Damage Prediction
+    // =========================================================================
+    uint32 incomingDamage = GetIncomingDamage(unit);
+    if (incomingDamage > 0 && maxHealth > 0)
+    {
+        // Calculate predicted health after incoming damage
+        float predictedHealthPct = ((unit->GetHealth() - incomingDamage) /
+                                     static_cast<float>(maxHealth)) * 100.0f;
+
+        // If predicted health is worse than current, use that for priority
+        if (predictedHealthPct < currentHealth)
+        {
+            // Blend current and predicted (60% predicted, 40% current)
+            priority = (predictedHealthPct * 0.6f) + (currentHealth * 0.4f);
+
+            // Emergency: if predicted death, huge priority boost
+            if (predictedHealthPct <= 0.0f)
+            {
+                priority -= 30.0f;
+            }
+            else if (predictedHealthPct < 20.0f)
+            {
+                priority -= 15.0f;
+            }
+        }
+    }
+
+    // =========================================================================
+    // Factor 2: Role Priority
+    // =========================================================================
+    priority += GetRolePriorityBonus(unit);
+
+    // =========================================================================
+    // Factor 3: Health Trend (rapidly dropping health)
+    // =========================================================================
+    priority += GetHealthTrendPenalty(unit, trend);
+
+    // Factor 4, the distance penalty, depends on the healer and is added by PartyMemberToHeal
+
+    // =========================================================================
+    // Factor 5: Critical Health Threshold Boost
+    // =========================================================================
+    if (currentHealth < sPlayerbotAIConfig->criticalHealth)
+    {
+        priority -= 25.0f;  // Critical health - big boost
+    }
+    else if (currentHealth < sPlayerbotAIConfig->lowHealth)
+    {
+        priority -= 10.0f;  // Low health - moderate boost
+    }
+
+    return priority;
+}
+
+void HealTriageBoard::UpdateHealthTrend(Unit* unit, HealthTrendData& trend, uint32 now)
+{
+    uint32 currentHealth = unit->GetHealth();
+    uint32 maxHealth = unit->GetMaxHealth();
+
+    // Calculate time delta
+    uint32 timeDelta = now - trend.lastUpdateTime;
+
+    // Only update if enough time has passed (100ms minimum to avoid noise)
+    if (timeDelta >= 100 && trend.lastUpdateTime > 0)
+    {
+        // Calculate health change rate (HP per second)
+        int32 healthDelta = static_cast<int32>(currentHealth) - static_cast<int32>(trend.lastHealth);
+        float newRate = (static_cast<float>(healthDelta) / static_cast<float>(timeDelta)) * 1000.0f;
+
+        // Exponential moving average to smooth out spikes
+        // Weight new samples more heavily when we have few samples
+        float alpha = (trend.sampleCount < 5) ? 0.5f : 0.3f;
+        trend.healthChangeRate = (alpha * newRate) + ((1.0f - alpha) * trend.healthChangeRate);
+
+        // Track damage intake (only negative health changes)
+        if (healthDelta < 0)
+        {
+            float damageRate = -newRate;
+            trend.avgDamageIntake = (alpha * damageRate) + ((1.0f - alpha) * trend.avgDamageIntake);
+        }
+
+        if (trend.sampleCount < 255)
+            trend.sampleCount++;
+    }
+
+    // Update stored values
+    trend.lastHealth = currentHealth;
+    trend.lastMaxHealth = maxHealth;
+    trend.lastUpdateTime = now;
+}
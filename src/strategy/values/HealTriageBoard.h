@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_HEALTRIAGEBOARD_H
+#define _PLAYERBOT_HEALTRIAGEBOARD_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "Common.h"
+#include "GroupBoardMgr.h"
+#include "ObjectGuid.h"
+
+class Group;
+class Player;
+class Unit;
+
+/**
+ * HealthTrendTracker - Tracks health changes over time for predictive healing
+ */
+struct HealthTrendData
+{
+    uint32 lastHealth = 0;
+    uint32 lastMaxHealth = 0;
+    uint32 lastUpdateTime = 0;
+    float healthChangeRate = 0.0f;     // Health change per second (negative = damage intake)
+    float avgDamageIntake = 0.0f;       // Average damage per second over recent window
+    uint8 sampleCount = 0;
+};
+
+// One group member, pet or charm as every healer of the group sees it
+struct HealTriageEntry
+{
+    ObjectGuid guid;
+    // heal priority without the healer's distance penalty, lower is more urgent
+    float priority = 200.0f;
+    bool isPlayer = false;
+    // heal spells cast on the unit by group members, healCaster is the first of them
+    uint8 healCasts = 0;
+    ObjectGuid healCaster;
+};
+
+/**
+ * HealTriageBoard - Heal priorities of one group on one map instance
+ *
+ * Rebuilt at most every 100 ms by whichever healer of the group ticks first, so health trends,
+ * incoming damage, role bonus and the heal casts in flight are computed once per group instead of once per healer.
+ * Healers only add their own distance penalty and range/LOS check and claim the target they picked.
+ * A board is only used by the thread updating its map.
+ */
+class HealTriageBoard
+{
+public:
+    bool IsStale(uint32 now) const;
+    void Rebuild(Player* bot, Group* group, uint32 now);
+
+    // sorted by priority, most urgent first
+    std::vector<HealTriageEntry> const& GetEntries() const { return entries; }
+
+    // another healer is already casting on the target or picked it recently
+    bool IsBeingHealed(HealTriageEntry const& entry, ObjectGuid healer, uint32 now) const;
+    void Claim(ObjectGuid target, ObjectGuid healer, uint32 now);
+
+private:
+    struct HealClaim
+    {
+        ObjectGuid healer;
+        uint32 until = 0;
+    };
+
+    typedef std::unordered_map<ObjectGuid, std::pair<uint8, ObjectGuid>> HealCastMap;
+
+    void AddEntry(Unit* unit, bool isRaid, float penalty, HealCastMap const& healCasts, uint32 now);
+    float CalculateHealPriority(Unit* unit, bool isRaid, HealthTrendData const& trend);
+    void UpdateHealthTrend(Unit* unit, HealthTrendData& trend, uint32 now);
+
+    std::vector<HealTriageEntry> entries;
+    std::unordered_map<ObjectGuid, HealthTrendData> trends;
+    std::unordered_map<ObjectGuid, HealClaim> claims;
+    uint32 builtAt = 0;
+    uint32 lastCleanup = 0;
+};
+
+typedef GroupBoardMgr<HealTriageBoard> HealTriageBoardMgr;
+
+#define sHealTriageBoardMgr HealTriageBoardMgr::instance()
+
+#endif
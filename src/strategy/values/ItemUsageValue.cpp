@@ -508,54 +508,36 @@ bool ItemUsageValue::IsItemUsefulForQuest(Player* player, ItemTemplate const* pr
     if (!botAI)
         return false;
 
-    for (uint8 slot = 0; slot < MAX_QUEST_LOG_SIZE; ++slot)
+    PlayerbotQuestIndex& questIndex = botAI->GetQuestIndex();
+
+    // Check if the item itself is needed for a quest
+    if (uint32 required = questIndex.GetRequiredItemCount(proto->ItemId))
     {
-        uint32 entry = player->GetQuestSlotQuestId(slot);
-        Quest const* quest = sObjectMgr->GetQuestTemplate(entry);
-        if (!quest)
-            continue;
+        if (AI_VALUE2(uint32, "item count", proto->Name1) < required)
+            return true; // Item is directly required for a quest
+    }
 
-        // Check if the item itself is needed for the quest
-        for (uint8 i = 0; i < 4; i++)
-        {
-            if (quest->RequiredItemId[i] == proto->ItemId)
-            {
-                if (AI_VALUE2(uint32, "item count", proto->Name1) >= quest->RequiredItemCount[i])
-                    continue;
+    // Check if the item has spells that create a required quest item
+    for (uint8 i = 0; i < MAX_ITEM_SPELLS; i++)
+    {
+        uint32 spellId = proto->Spells[i].SpellId;
+        if (!spellId)
+            continue;
 
-                return true; // Item is directly required for a quest
-            }
-        }
+        SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellId);
+        if (!spellInfo)
+            continue;
 
-        // Check if the item has spells that create a required quest item
-        for (uint8 i = 0; i < MAX_ITEM_SPELLS; i++)
+        for (uint8 effectIndex = 0; effectIndex < MAX_SPELL_EFFECTS; effectIndex++)
         {
-            uint32 spellId = proto->Spells[i].SpellId;
-            if (!spellId)
+            if (spellInfo->Effects[effectIndex].Effect != SPELL_EFFECT_CREATE_ITEM)
                 continue;
 
-            SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellId);
-            if (!spellInfo)
-                continue;
-
-            for (uint8 effectIndex = 0; effectIndex < MAX_SPELL_EFFECTS; effectIndex++)
+            uint32 createdItemId = spellInfo->Effects[effectIndex].ItemType;
+            if (uint32 required = questIndex.GetRequiredItemCount(createdItemId))
             {
-                if (spellInfo->Effects[effectIndex].Effect == SPELL_EFFECT_CREATE_ITEM)
-                {
-                    uint32 createdItemId = spellInfo->Effects[effectIndex].ItemType;
-
-                    // Check if the created item is required for a quest
-                    for (uint8 j = 0; j < 4; j++)
-                    {
-                        if (quest->RequiredItemId[j] == createdItemId)
-                        {
-                            if (AI_VALUE2(uint32, "item count", createdItemId) >= quest->RequiredItemCount[j])
-                                continue;
-
-                            return true; // Item is useful because it creates a required quest item
-                        }
-                    }
-                }
+                if (AI_VALUE2(uint32, "item count", createdItemId) < required)
+                    return true; // Item is useful because it creates a required quest item
             }
         }
     }
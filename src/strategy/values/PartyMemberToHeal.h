@@ -7,25 +7,11 @@
 #define _PLAYERBOT_PARTYMEMBERTOHEAL_H
 
 #include "PartyMemberValue.h"
-#include <unordered_map>
 
 class Pet;
 class PlayerbotAI;
 class Unit;
 
-/**
- * HealthTrendTracker - Tracks health changes over time for predictive healing
- */
-struct HealthTrendData
-{
-    uint32 lastHealth = 0;
-    uint32 lastMaxHealth = 0;
-    uint32 lastUpdateTime = 0;
-    float healthChangeRate = 0.0f;     // Health change per second (negative = damage intake)
-    float avgDamageIntake = 0.0f;       // Average damage per second over recent window
-    uint8 sampleCount = 0;
-};
-
 /**
  * PartyMemberToHeal - Enhanced with predictive healing
  *
@@ -35,6 +21,8 @@ struct HealthTrendData
  * 3. Role priority (tank > healer > dps)
  * 4. Health trend (rapidly dropping health gets priority)
  * 5. Distance penalty
+ *
+ * All but the distance penalty come from the group's HealTriageBoard.
  */
 class PartyMemberToHeal : public PartyMemberValue
 {
@@ -49,34 +37,7 @@ protected:
     bool Check(Unit* player) override;
 
 private:
-    /**
-     * Calculate heal priority score for a unit (lower = higher priority)
-     */
-    float CalculateHealPriority(Unit* unit, bool isRaid);
-
-    /**
-     * Get role priority bonus (subtracted from score)
-     * Tank = -20, Healer = -10, DPS = 0
-     */
-    float GetRolePriorityBonus(Unit* unit);
-
-    /**
-     * Get incoming damage for a unit from AnticipatoryThreat system
-     */
-    uint32 GetIncomingDamage(Unit* unit);
-
-    /**
-     * Get health trend penalty (added to score if health stable, subtracted if dropping fast)
-     */
-    float GetHealthTrendPenalty(Unit* unit);
-
-    /**
-     * Update health trend tracking for a unit
-     */
-    void UpdateHealthTrend(Unit* unit);
-
-    // Health trend tracking per unit (static to persist across calculations)
-    static std::unordered_map<uint64, HealthTrendData> s_healthTrends;
+    float GetDistancePenalty(Unit* unit);
 };
 
 class PartyMemberToProtect : public PartyMemberValue